@@ -0,0 +1,25 @@
+#ifndef ALGINE_BATCHRENDERER_CONSTANTS_H
+#define ALGINE_BATCHRENDERER_CONSTANTS_H
+
+#define constant(name, val) constexpr char name[] = val;
+
+namespace algine {
+namespace Module {
+namespace BatchRenderer {
+    namespace Settings {
+        constant(BatchRenderer, "ALGINE_BATCH_RENDERER")
+        constant(DrawParameters, "ALGINE_BATCH_DRAW_PARAMETERS")
+    }
+
+    namespace Vars {
+        constant(Draws, "batchDraws")
+        constant(Materials, "batchMaterials")
+        constant(DrawOffset, "batchDrawOffset")
+    }
+}
+}
+}
+
+#undef constant
+
+#endif //ALGINE_BATCHRENDERER_CONSTANTS_H
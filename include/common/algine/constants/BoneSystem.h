@@ -9,15 +9,25 @@ namespace BoneSystem {
     namespace Settings {
         constant(MaxBoneAttribsPerVertex, "MAX_BONE_ATTRIBS_PER_VERTEX")
         constant(MaxBones, "MAX_BONES")
+        constant(BakedAnimation, "ALGINE_BAKED_ANIMATION")
+        constant(Palette, "ALGINE_BONE_SYSTEM_PALETTE")
+        constant(DualQuaternion, "ALGINE_DUAL_QUATERNION_SKINNING")
+        constant(DualQuaternionScale, "ALGINE_DUAL_QUATERNION_SCALE")
     }
 
     namespace Vars {
         constant(InBoneIds, "inBoneIds[0]") // integer
         constant(InBoneWeights, "inBoneWeights[0]")
+        constant(BakedBones, "bakedBones")
+        constant(BakedPose, "bakedPose")
+        constant(BonePalette, "bonePalette")
+        constant(BoneBaseOffset, "boneBaseOffset")
+        constant(BoneAttribsPerVertex, "boneAttribsPerVertex") // palette mode
 
         namespace Block {
             constant(Name, "BoneSystem")
             constant(Bones, "bones")
+            constant(BoneScales, "boneScales")
             constant(BoneAttribsPerVertex, "boneAttribsPerVertex")
         }
     }
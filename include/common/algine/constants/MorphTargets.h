@@ -0,0 +1,25 @@
+#ifndef ALGINE_MORPHTARGETS_CONSTANTS_H
+#define ALGINE_MORPHTARGETS_CONSTANTS_H
+
+#define constant(name, val) constexpr char name[] = val;
+
+namespace algine {
+namespace Module {
+namespace MorphTargets {
+    namespace Settings {
+        constant(MorphTargets, "ALGINE_MORPH_TARGETS")
+        constant(MaxActiveTargets, "MAX_MORPH_TARGETS")
+    }
+
+    namespace Vars {
+        constant(Deltas, "morphDeltas")
+        constant(Targets, "morphTargets[0]")
+        constant(TargetsCount, "morphTargetsCount")
+    }
+}
+}
+}
+
+#undef constant
+
+#endif //ALGINE_MORPHTARGETS_CONSTANTS_H
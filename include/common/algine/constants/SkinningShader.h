@@ -0,0 +1,27 @@
+#ifndef ALGINE_SKINNINGSHADER_H
+#define ALGINE_SKINNINGSHADER_H
+
+#define constant(name, val) constexpr char name[] = val;
+
+namespace algine {
+    namespace SkinningShader {
+        namespace Settings {
+            constant(BoneSystem, "ALGINE_BONE_SYSTEM")
+        }
+
+        namespace Vars {
+            constant(InPos, "a_Position")
+            constant(InNormal, "a_Normal")
+            constant(InTangent, "a_Tangent")
+            constant(InBitangent, "a_Bitangent")
+            constant(OutPos, "skinnedPosition")
+            constant(OutNormal, "skinnedNormal")
+            constant(OutTangent, "skinnedTangent")
+            constant(OutBitangent, "skinnedBitangent")
+        }
+    }
+}
+
+#undef constant
+
+#endif //ALGINE_SKINNINGSHADER_H
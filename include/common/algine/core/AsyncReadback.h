@@ -0,0 +1,87 @@
+#ifndef ALGINE_ASYNCREADBACK_H
+#define ALGINE_ASYNCREADBACK_H
+
+#include <algine/core/buffers/Buffer.h>
+#include <algine/core/DataType.h>
+#include <algine/types.h>
+
+#include <tulz/Array.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace algine {
+/**
+ * Non-blocking readback of buffer and framebuffer data. Data is
+ * copied on the GPU side into a staging buffer (<code>GL_COPY_WRITE_BUFFER</code>
+ * or <code>GL_PIXEL_PACK_BUFFER</code>) and a fence is inserted.
+ * Staging buffer is mapped only when the fence is signaled, so the CPU
+ * doesn't wait for the GPU, unless <code>take</code> is called too early.
+ * Staging buffers are reused between requests
+ */
+class AsyncReadback {
+public:
+    typedef uint64 Handle;
+
+    static constexpr Handle InvalidHandle = 0;
+
+public:
+    AsyncReadback();
+    ~AsyncReadback();
+
+    /// buffer doesn't need to be bound
+    Handle read(const Buffer *buffer, uint offset, uint size);
+
+    /**
+     * Reads pixels of the color attachment (or depth, if
+     * <code>format</code> is <code>DepthComponent</code>); framebuffer must be bound.
+     * Rows are tightly packed (<code>GL_PACK_ALIGNMENT</code> 1)
+     * @param attachment - e.g. <code>Framebuffer::ColorAttachmentZero</code>
+     * @param format - base format, e.g. <code>Texture::RGBA</code>
+     * @param dataType
+     */
+    Handle readPixels(uint attachment, uint x, uint y, uint width, uint height,
+                      uint format, DataType dataType = DataType::Float);
+
+    /// @return true if data can be taken without waiting
+    bool isReady(Handle handle);
+
+    /**
+     * Maps staging buffer, copies data and releases the request.
+     * Waits if the request is not ready yet
+     */
+    tulz::Array<byte> take(Handle handle);
+
+    void cancel(Handle handle);
+
+    uint getPendingCount() const;
+
+    /// @return count of <code>take</code> calls which had to wait for the GPU
+    uint getWaitsCount() const;
+
+private:
+    struct Staging {
+        uint id;
+        uint size;
+    };
+
+    struct Request {
+        Staging staging;
+        uint size;
+        void *fence;
+    };
+
+private:
+    Staging acquire(uint size);
+    void release(const Request &request);
+    Handle push(const Staging &staging, uint size);
+
+private:
+    std::unordered_map<Handle, Request> m_requests;
+    std::vector<Staging> m_free;
+    Handle m_lastHandle = InvalidHandle;
+    uint m_waitsCount = 0;
+};
+}
+
+#endif //ALGINE_ASYNCREADBACK_H
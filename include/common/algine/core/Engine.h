@@ -12,9 +12,11 @@ class Framebuffer;
 class Renderbuffer;
 class Texture2D;
 class TextureCube;
+class TextureBuffer;
 class ArrayBuffer;
 class IndexBuffer;
 class UniformBuffer;
+class IndirectBuffer;
 class ShaderProgram;
 class InputLayout;
 
@@ -24,6 +26,7 @@ class Engine {
     friend class Texture;
     friend class Texture2D;
     friend class TextureCube;
+    friend class TextureBuffer;
     friend class Buffer;
     friend class ShaderProgram;
     friend class InputLayout;
@@ -50,14 +53,17 @@ public:
     static Renderbuffer* getBoundRenderbuffer();
     static Texture2D* getBoundTexture2D();
     static TextureCube* getBoundTextureCube();
+    static TextureBuffer* getBoundTextureBuffer();
     static ArrayBuffer* getBoundArrayBuffer();
     static IndexBuffer* getBoundIndexBuffer();
     static UniformBuffer* getBoundUniformBuffer();
+    static IndirectBuffer* getBoundIndirectBuffer();
     static ShaderProgram* getBoundShaderProgram();
     static InputLayout* getBoundInputLayout();
 
     static std::string getGPUVendor();
     static std::string getGPURenderer();
+    static bool isExtensionSupported(const std::string &name);
 
     static uint getError();
 
@@ -66,9 +72,11 @@ public:
     static Renderbuffer* defaultRenderbuffer();
     static Texture2D* defaultTexture2D();
     static TextureCube* defaultTextureCube();
+    static TextureBuffer* defaultTextureBuffer();
     static ArrayBuffer* defaultArrayBuffer();
     static IndexBuffer* defaultIndexBuffer();
     static UniformBuffer* defaultUniformBuffer();
+    static IndirectBuffer* defaultIndirectBuffer();
     static ShaderProgram* defaultShaderProgram();
     static InputLayout* defaultInputLayout();
 
@@ -104,6 +112,7 @@ public:
     static void disableDepthMask();
 
     static void drawElements(uint start, uint count, uint polyType = Triangle);
+    static void drawElementsInstanced(uint start, uint count, uint instanceCount, uint polyType = Triangle);
     static void setDepthTestMode(uint mode);
     static void setFaceCullingMode(uint mode);
     static void setViewport(uint width, uint height, uint x = 0, uint y = 0);
@@ -126,9 +135,11 @@ private:
     static Renderbuffer *m_defaultRenderbuffer;
     static Texture2D *m_defaultTexture2D;
     static TextureCube *m_defaultTextureCube;
+    static TextureBuffer *m_defaultTextureBuffer;
     static ArrayBuffer *m_defaultArrayBuffer;
     static IndexBuffer *m_defaultIndexBuffer;
     static UniformBuffer *m_defaultUniformBuffer;
+    static IndirectBuffer *m_defaultIndirectBuffer;
     static ShaderProgram *m_defaultShaderProgram;
     static InputLayout *m_defaultInputLayout;
 
@@ -140,9 +151,11 @@ private:
     static Renderbuffer *m_boundRenderbuffer;
     static Texture2D *m_boundTexture2D;
     static TextureCube *m_boundTextureCube;
+    static TextureBuffer *m_boundTextureBuffer;
     static ArrayBuffer *m_boundArrayBuffer;
     static IndexBuffer *m_boundIndexBuffer;
     static UniformBuffer *m_boundUniformBuffer;
+    static IndirectBuffer *m_boundIndirectBuffer;
     static ShaderProgram *m_boundShaderProgram;
     static InputLayout *m_boundInputLayout;
 };
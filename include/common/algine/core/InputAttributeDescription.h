@@ -25,12 +25,20 @@ public:
     uint getOffset() const;
     void setOffset(uint offset);
 
+    /**
+     * @param divisor - 0 to advance attribute per vertex,
+     * N to advance it once per N instances
+     */
+    void setDivisor(uint divisor);
+    uint getDivisor() const;
+
 public:
     DataType m_dataType = DataType::Float;
     uint m_location = LocationAbsent;
     uint m_count = 4;
     uint m_stride = 0;
     uint m_offset = 0;
+    uint m_divisor = 0;
 };
 }
 
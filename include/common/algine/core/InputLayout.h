@@ -20,6 +20,8 @@ public:
     void addAttribute(const InputAttributeDescription &inputAttribDescription, const ArrayBuffer *arrayBuffer) const;
     void setIndexBuffer(const IndexBuffer *indexBuffer) const;
 
+    uint getId() const;
+
     implementVariadicCreate(InputLayout)
     implementVariadicDestroy(InputLayout)
 
@@ -0,0 +1,110 @@
+#ifndef ALGINE_RENDERQUEUE_H
+#define ALGINE_RENDERQUEUE_H
+
+#include <algine/core/shader/ShaderProgram.h>
+#include <algine/core/InputLayout.h>
+#include <algine/types.h>
+
+#include <functional>
+#include <cstdint>
+#include <vector>
+
+namespace algine {
+/**
+ * Collects draws during the frame, sorts them by the packed 64-bit key
+ * and executes them with the minimal amount of state changes.
+ * Key layout, from the most significant bits:
+ * <br>opaque: pass (4), program (12), material (16), input layout (12), depth (20)
+ * <br>transparent: pass (4), inverted depth (24), program (12), material (12), input layout (12)
+ * <br>so opaque draws are grouped by state and then sorted front-to-back,
+ * transparent draws are sorted back-to-front
+ */
+class RenderQueue {
+public:
+    constexpr static uint MaxPasses = 16;
+    constexpr static uint NoMaterial = 0;
+
+    struct Item {
+        ShaderProgram *program;
+        InputLayout *inputLayout;
+        uint material; // application defined id, 0 if none
+        uint start;    // first index
+        uint count;    // indices count
+        float depth;   // view space distance
+        void *userData;
+        uint pass;
+    };
+
+    struct Stats {
+        uint programChanges;
+        uint materialChanges;
+        uint inputLayoutChanges;
+
+        uint total() const;
+    };
+
+    /// called when material is changed, program is bound
+    using MaterialCallback = std::function<void(ShaderProgram *program, uint material)>;
+
+    /// called before each draw, e.g. to set transformation uniforms
+    using DrawCallback = std::function<void(ShaderProgram *program, const Item &item)>;
+
+public:
+    void clear();
+    void submit(const Item &item);
+
+    /// builds keys and sorts draws
+    void sort();
+
+    /// issues draws in the sorted order
+    void execute();
+
+    /**
+     * Draws of the transparent passes are sorted back-to-front
+     * before grouping by state
+     */
+    void setPassTransparent(uint pass, bool transparent);
+    bool isPassTransparent(uint pass) const;
+
+    /// range of the depth, values outside are clamped
+    void setDepthRange(float near, float far);
+
+    void setMaterialCallback(const MaterialCallback &callback);
+    void setDrawCallback(const DrawCallback &callback);
+
+    uint getItemsCount() const;
+
+    /// @return state changes of the last sorted frame in the submission order
+    const Stats& getUnsortedStats() const;
+
+    /// @return state changes of the last executed frame
+    const Stats& getSortedStats() const;
+
+public:
+    static std::uint64_t makeKey(const Item &item, bool transparent, float near, float far);
+
+private:
+    /// counts state changes for the current <code>m_order</code>
+    Stats countChanges() const;
+
+private:
+    std::vector<Item> m_items;
+    std::vector<std::uint64_t> m_keys;
+    std::vector<uint> m_order;
+
+private:
+    std::vector<std::uint64_t> m_keysTmp;
+    std::vector<uint> m_orderTmp;
+
+private:
+    uint m_transparentPasses = 0;
+    float m_depthNear = 0.0f;
+    float m_depthFar = 1000.0f;
+    MaterialCallback m_materialCallback;
+    DrawCallback m_drawCallback;
+    Stats m_unsortedStats {};
+    Stats m_sortedStats {};
+};
+}
+
+#endif //ALGINE_RENDERQUEUE_H
@@ -0,0 +1,49 @@
+#ifndef ALGINE_STATECACHE_H
+#define ALGINE_STATECACHE_H
+
+#include <algine/types.h>
+
+namespace algine {
+/**
+ * Shadow copy of the GL binding state: buffers per target, textures
+ * per unit and target, active unit, program, input layout, framebuffer
+ * and renderbuffer. Calls which do not change the state are skipped.
+ * Objects of the engine use it automatically; if bindings are changed
+ * with raw GL calls, call <code>invalidate</code>
+ */
+class StateCache {
+public:
+    static void bindBuffer(uint target, uint id);
+    static void bindBufferBase(uint target, uint index, uint id);
+    static void bindBufferRange(uint target, uint index, uint id, uint offset, uint size);
+    static void bindTexture(uint target, uint id);
+    static void activeTexture(uint slot);
+    static void useProgram(uint id);
+    static void bindVertexArray(uint id);
+    static void bindFramebuffer(uint id);
+    static void bindRenderbuffer(uint id);
+
+    // must be called when objects are deleted, since ids can be reused
+
+    static void onBufferDeleted(uint id);
+    static void onTextureDeleted(uint id);
+    static void onProgramDeleted(uint id);
+    static void onVertexArrayDeleted(uint id);
+    static void onFramebufferDeleted(uint id);
+    static void onRenderbufferDeleted(uint id);
+
+    /// forgets all cached state, the next calls will be issued
+    static void invalidate();
+
+    /// if disabled, all calls are issued
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /// @return amount of skipped calls, for profiling
+    static uint getElidedCalls();
+    static uint getIssuedCalls();
+    static void resetCounters();
+};
+}
+
+#endif //ALGINE_STATECACHE_H
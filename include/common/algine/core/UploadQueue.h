@@ -0,0 +1,111 @@
+#ifndef ALGINE_UPLOADQUEUE_H
+#define ALGINE_UPLOADQUEUE_H
+
+#include <algine/core/buffers/Buffer.h>
+#include <algine/core/texture/Texture2D.h>
+#include <algine/types.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+
+namespace algine {
+/**
+ * Deferred uploads of buffer and texture data. Enqueued data is copied
+ * to the staging buffer in <code>process</code>, which should be called
+ * once per frame, within the per-frame byte budget. Buffers are filled
+ * with <code>glCopyBufferSubData</code>, textures are read from the
+ * staging buffer bound as <code>GL_PIXEL_UNPACK_BUFFER</code>.
+ * Completion is tracked with fences and is never waited for
+ */
+class UploadQueue {
+public:
+    typedef uint64 Ticket;
+
+    static constexpr Ticket InvalidTicket = 0;
+
+public:
+    UploadQueue();
+    ~UploadQueue();
+
+    /**
+     * @param buffer - destination, must have enough storage
+     * @param offset - destination offset
+     */
+    Ticket enqueue(Buffer *buffer, uint offset, std::vector<byte> data);
+    Ticket enqueue(Buffer *buffer, uint offset, uint size, const void *data);
+
+    /**
+     * Uploads the whole texture level; texture format and dimensions must be
+     * already set. Rows must be aligned according to <code>GL_UNPACK_ALIGNMENT</code>
+     */
+    Ticket enqueue(Texture2D *texture, uint dataFormat, uint dataType, std::vector<byte> data,
+                   bool generateMipmap = false);
+
+    /**
+     * Decodes image and enqueues it, texture storage is allocated during
+     * the upload. Mipmaps are generated as in <code>Texture2D::fromFile</code>
+     * @return InvalidTicket if file can't be loaded
+     */
+    Ticket enqueue(Texture2D *texture, const std::string &path, bool flipImage = true);
+
+    /**
+     * Checks finished uploads and issues the pending ones
+     * while the frame budget is not exceeded; at least one upload
+     * is issued per call, even if it exceeds the budget
+     */
+    void process();
+
+    bool isComplete(Ticket ticket) const;
+
+    /// @param budget - max bytes per <code>process</code> call
+    void setFrameBudget(uint budget);
+
+    uint getFrameBudget() const;
+    uint getPendingCount() const;
+    uint getPendingBytes() const;
+    uint getInFlightCount() const;
+
+    /// @return bytes issued by the last <code>process</code> call
+    uint getProcessedBytes() const;
+
+private:
+    enum class Type {
+        Buffer,
+        Texture
+    };
+
+    struct Upload {
+        Type type;
+        Ticket ticket;
+        std::vector<byte> data;
+        Buffer *buffer;
+        uint offset;
+        Texture2D *texture;
+        uint dataFormat;
+        uint dataType;
+        bool generateMipmap;
+    };
+
+    struct Batch {
+        void *fence;
+        Ticket lastTicket;
+    };
+
+private:
+    Ticket push(Upload upload);
+
+private:
+    std::deque<Upload> m_pending;
+    std::deque<Batch> m_inFlight;
+    uint m_stagingId = 0;
+    uint m_stagingSize = 0;
+    uint m_frameBudget = 4 * 1024 * 1024;
+    uint m_pendingBytes = 0;
+    uint m_processedBytes = 0;
+    Ticket m_lastTicket = InvalidTicket;
+    Ticket m_completedTicket = InvalidTicket;
+};
+}
+
+#endif //ALGINE_UPLOADQUEUE_H
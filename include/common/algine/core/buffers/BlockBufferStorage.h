@@ -4,10 +4,18 @@
 #include <algine/core/buffers/Buffer.h>
 #include <algine/types.h>
 
+#include <functional>
+#include <cstdint>
 #include <vector>
 #include <tulz/Array.h>
 
 namespace algine {
+/**
+ * Fixed-size blocks in one buffer. Free blocks are tracked by a bitset,
+ * so allocation is a find-first-set over 64-block words. If the storage is
+ * full and auto growth is enabled, capacity is doubled; old data is copied
+ * on the GPU side
+ */
 class BlockBufferStorage {
 public:
     constexpr static uint StorageFull = -1;
@@ -18,6 +26,9 @@ public:
         uint newIndex;
     };
 
+    /// called for each moved block, owners must update stored indices
+    using RemapCallback = std::function<void(uint oldIndex, uint newIndex)>;
+
 public:
     ~BlockBufferStorage();
 
@@ -25,37 +36,70 @@ public:
     void unbind() const;
 
     void allocateStorage();
+
+    /// buffer must be bound, stays bound
     void reallocateStorage();
     void allocateBlock(uint blockIndex);
     void freeBlock(uint blockIndex);
+    /**
+     * @return block index or <code>StorageFull</code> if auto growth
+     * is disabled. Growth binds the buffer
+     */
     uint allocateBlock();
 
     void write(uint offset, uint size, const void *data);
     void write(uint blockIndex, uint offset, uint size, const void *data);
+    /**
+     * Updates only the map, block data is not moved
+     * @return moves which must be applied by the caller
+     */
     std::vector<DefragmentationInfo> defragmentMap();
 
+    /**
+     * Moves allocated blocks to the beginning of the storage on the GPU side,
+     * notifies owners via remap callback and optionally shrinks the storage.
+     * Shrinking binds the buffer
+     * @param shrink - if true, capacity is reduced to twice the allocated blocks count
+     * @return applied moves
+     */
+    std::vector<DefragmentationInfo> compact(bool shrink = true);
+
     void setBlockSize(uint size, uint alignment = 1);
     void setBlocksCount(uint count);
     void setBufferType(uint type);
     void setBufferUsage(uint usage);
+    void setAutoGrowth(bool autoGrowth);
+    void setRemapCallback(const RemapCallback &callback);
 
     uint capacity() const;
     uint getBlockSize() const;
     uint getBlocksCount() const;
     uint getBufferType() const;
     uint getBufferUsage() const;
+    uint getFreeBlocksCount() const;
+    bool isAutoGrowth() const;
     uint getBlockOffset(uint index) const;
     Buffer* getBuffer() const;
     std::vector<uint> getFreeBlocks() const;
     std::vector<uint> getAllocatedBlocks() const;
     bool isBlockFree(uint index) const;
-    const tulz::Array<bool>& getBufferMap() const;
+    tulz::Array<bool> getBufferMap() const;
+
+private:
+    void setBlockFree(uint index, bool free);
+    void resizeMap(uint blocksCount);
 
 private:
-    tulz::Array<bool> m_bufferMap;
+    // uint64 is 32-bit on LLP64 (Windows), so the fixed width type is used
+    std::vector<std::uint64_t> m_freeMap; // bit is set if block is free
+    uint m_mapSize = 0; // in blocks
+    uint m_freeBlocksCount = 0;
+    uint m_firstFreeWord = 0; // there are no free blocks before it
     Buffer *m_buffer = nullptr;
     uint m_blockSize = 0, m_blocksCount = 0;
     uint m_type = 0, m_usage = 0;
+    bool m_autoGrowth = true;
+    RemapCallback m_remapCallback;
 };
 }
 
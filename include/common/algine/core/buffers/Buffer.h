@@ -18,9 +18,19 @@ public:
     enum Type {
         Array = 0x8892,
         Index = 0x8893,
-        Uniform = 0x8A11
+        Uniform = 0x8A11,
+        DrawIndirect = 0x8F3F
     };
 
+    enum_class(StorageFlags,
+        MapRead = 0x0001,
+        MapWrite = 0x0002,
+        MapPersistent = 0x0040,
+        MapCoherent = 0x0080,
+        DynamicStorage = 0x0100,
+        ClientStorage = 0x0200
+    );
+
     enum_class(MapMode,
         Read = 0x0001,
         Write = 0x0002,
@@ -37,15 +47,42 @@ public:
     void bind() const;
     void unbind() const;
     void setData(uint size, const void *data, uint usage);
+
+    /**
+     * Allocates immutable storage (<code>glBufferStorage</code>), its size
+     * can't be changed by <code>setData</code>, only by <code>reallocate</code>.
+     * If immutable storage is not supported, <code>glBufferData</code> is used:
+     * <code>DynamicDraw</code> if <code>DynamicStorage</code> flag is set,
+     * <code>StaticDraw</code> otherwise
+     * @param flags - combination of <code>StorageFlags</code>
+     */
+    void setStorage(uint size, const void *data, uint flags);
     void updateData(uint offset, uint size, const void *data);
     tulz::Array<byte> getData(uint offset, uint size);
 
     void* mapData(uint offset, uint size, uint access);
     bool unmapData();
 
+    /**
+     * Allocates new storage and copies old data to it on the GPU side,
+     * so there is no read back. Buffer id changes; buffer must be bound
+     * and stays bound
+     * @param size - new size, the first min(oldSize, size) bytes are kept
+     * @param usage
+     */
+    void reallocate(uint size, uint usage);
+
+    /// GPU-side copy, buffers are not bound to their targets
+    static void copy(const Buffer *src, Buffer *dst, uint srcOffset, uint dstOffset, uint size);
+
+    /// size of the data store, tracked on the CPU side
     uint size() const;
     uint getId() const;
     uint getType() const;
+    bool isImmutable() const;
+
+    /// requires OpenGL 4.4 or <code>GL_ARB_buffer_storage</code>
+    static bool isStorageSupported();
 
 protected:
     explicit Buffer(uint target);
@@ -53,6 +90,9 @@ protected:
 public:
     uint m_target = 0;
     uint m_id = 0;
+    uint m_size = 0;
+    uint m_storageFlags = 0;
+    bool m_immutable = false;
 };
 }
 
@@ -0,0 +1,75 @@
+#ifndef ALGINE_BUFFERMIRROR_H
+#define ALGINE_BUFFERMIRROR_H
+
+#include <algine/core/buffers/Buffer.h>
+
+#include <vector>
+
+namespace algine {
+/**
+ * CPU copy of the buffer data. Writes go to memory and mark dirty ranges,
+ * <code>flush</code> merges ranges and uploads them with the minimum
+ * amount of <code>glBufferSubData</code> calls. Writes which do not change
+ * data are skipped
+ */
+class BufferMirror {
+public:
+    struct Stats {
+        uint writes = 0; // write calls, each one used to be an upload
+        uint writtenBytes = 0;
+        uint uploads = 0;
+        uint uploadedBytes = 0;
+
+        inline int getSavedCalls() const {
+            return static_cast<int>(writes) - static_cast<int>(uploads);
+        }
+
+        inline int getSavedBytes() const {
+            return static_cast<int>(writtenBytes) - static_cast<int>(uploadedBytes);
+        }
+    };
+
+public:
+    /// marks the whole buffer dirty, since GPU data is not known
+    void resize(uint size);
+
+    /// @throws std::invalid_argument if the range exceeds the mirror size
+    void write(uint offset, uint size, const void *data);
+
+    /**
+     * Uploads dirty ranges, buffer must be bound
+     * @param buffer
+     */
+    void flush(Buffer *buffer);
+
+    /**
+     * Ranges separated by no more than <code>gap</code> bytes are uploaded
+     * as one, since one bigger upload is cheaper than several small ones
+     * @param gap - in bytes, 0 means only adjacent ranges are merged
+     */
+    void setMergeGap(uint gap);
+
+    uint getMergeGap() const;
+    uint size() const;
+    const byte* data() const;
+    bool isDirty() const;
+
+    /// @return statistics of the last flush
+    const Stats& getStats() const;
+
+private:
+    struct Range {
+        uint begin;
+        uint end;
+    };
+
+private:
+    std::vector<byte> m_data;
+    std::vector<Range> m_dirtyRanges;
+    uint m_mergeGap = 64;
+    Stats m_stats;
+    Stats m_frameStats;
+};
+}
+
+#endif //ALGINE_BUFFERMIRROR_H
@@ -2,6 +2,7 @@
 #define ALGINE_BUFFERWRITER_H
 
 #include <algine/core/buffers/Buffer.h>
+#include <algine/core/buffers/BufferMirror.h>
 
 #include <tulz/Array.h>
 #include <vector>
@@ -38,12 +39,28 @@ public:
     void end();
     void write(uint offset, uint size, const void *data);
 
+    /**
+     * If mirror is enabled, writes go to the CPU copy
+     * and are uploaded only by <code>flush</code>
+     * @param bufferSize
+     */
+    void enableMirror(uint bufferSize);
+    void disableMirror();
+
+    /// uploads changed data, must be called between begin and end
+    void flush();
+
     void setBuffer(Buffer *buffer);
 
     Buffer* getBuffer() const;
+    bool isMirrorEnabled() const;
+    const BufferMirror& getMirror() const;
+    BufferMirror& mirror();
 
 private:
     Buffer *m_buffer = nullptr;
+    BufferMirror m_mirror;
+    bool m_mirrorEnabled = false;
 };
 }
 
@@ -0,0 +1,21 @@
+#ifndef ALGINE_INDIRECTBUFFER_H
+#define ALGINE_INDIRECTBUFFER_H
+
+#include <algine/core/buffers/Buffer.h>
+#include <algine/templates.h>
+
+namespace algine {
+/**
+ * Source of the indirect draw commands (<code>GL_DRAW_INDIRECT_BUFFER</code>).
+ * Requires OpenGL 4.0 or OpenGL ES 3.1
+ */
+class IndirectBuffer: public Buffer {
+public:
+    IndirectBuffer();
+
+    implementVariadicCreate(IndirectBuffer)
+    implementVariadicDestroy(IndirectBuffer)
+};
+}
+
+#endif //ALGINE_INDIRECTBUFFER_H
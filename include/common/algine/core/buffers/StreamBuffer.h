@@ -0,0 +1,97 @@
+#ifndef ALGINE_STREAMBUFFER_H
+#define ALGINE_STREAMBUFFER_H
+
+#include <algine/core/buffers/UniformBuffer.h>
+
+namespace algine {
+/**
+ * Ring buffer for the data which is rewritten every frame, e.g. uniform blocks.
+ * Buffer is split into <code>FramesCount</code> regions, one per frame in flight,
+ * so writes of the current frame never touch data the GPU is still reading
+ * <br>Persistent: buffer is mapped once with persistent & coherent flags
+ * (<code>GL_ARB_buffer_storage</code>), region reuse is synchronized with fences
+ * <br>Orphaning: fallback if buffer storage is not supported or persistent mapping
+ * fails. Ranges are mapped unsynchronized, buffer storage is orphaned when the ring wraps around
+ */
+class StreamBuffer {
+public:
+    enum class Mode {
+        Persistent,
+        Orphaning
+    };
+
+    struct Range {
+        void *data = nullptr;
+        uint offset = 0;
+        uint size = 0;
+    };
+
+    static constexpr uint FramesCount = 3;
+
+public:
+    StreamBuffer();
+    ~StreamBuffer();
+
+    /**
+     * (Re)creates buffer
+     * @param frameSize - max amount of bytes written per frame
+     * @param alignment - alignment of the allocated ranges,
+     * e.g. <code>UniformBuffer::getOffsetAlignment()</code>
+     * @param mode - preferred mode, Orphaning is used if Persistent is not supported
+     * or the persistent mapping fails
+     */
+    void init(uint frameSize, uint alignment, Mode mode = Mode::Persistent);
+
+    /// makes the next region current, waits for the GPU if it still reads it
+    void beginFrame();
+
+    /// must be called after the last draw call which uses data of the current frame
+    void endFrame();
+
+    /**
+     * Allocates range in the current region. Range must be committed
+     * before it is used by the GPU
+     * <br>In Orphaning mode each range is mapped separately, so only one
+     * range can be outstanding: allocating the next one before the
+     * previous one is committed throws <code>std::runtime_error</code>
+     */
+    Range allocate(uint size);
+    void commit(const Range &range);
+
+    /// allocates range, copies data to it and commits it
+    Range write(const void *data, uint size);
+
+    /// binds range to the uniform buffer binding point
+    void bindRange(uint bindingPoint, const Range &range) const;
+
+    Mode getMode() const;
+    UniformBuffer* getBuffer() const;
+    uint getFrameSize() const;
+    uint getFrameIndex() const;
+    uint getUsedSize() const;
+
+    /// @return how many times the CPU had to wait for the GPU, for profiling
+    uint getWaitsCount() const;
+    void resetWaitsCount();
+
+    static bool isPersistentMappingSupported();
+
+private:
+    void waitFence(Index frame);
+    void deleteFences();
+
+private:
+    UniformBuffer *m_buffer = nullptr;
+    byte *m_mapped = nullptr;
+    void *m_fences[FramesCount] {};
+    Mode m_mode = Mode::Orphaning;
+    uint m_frameSize = 0;
+    uint m_alignment = 1;
+    Index m_frame = 0;
+    uint m_frameOffset = 0;
+    uint m_waitsCount = 0;
+    bool m_mappedRange = false; // Orphaning mode only
+};
+}
+
+#endif //ALGINE_STREAMBUFFER_H
@@ -23,6 +23,9 @@ public:
     void setName(const std::string &name);
     void setBindingPoint(uint bindingPoint);
 
+    /// for blocks with known layout (e.g. std140), instead of <code>init</code>
+    void setSize(uint size);
+
     UniformBuffer* getBuffer() const;
     std::string getName() const;
     uint getBindingPoint() const;
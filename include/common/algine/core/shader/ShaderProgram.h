@@ -2,6 +2,8 @@
 #define ALGINE_SHADERPROGRAM_H
 
 #include <algine/core/shader/ShaderProgramPtr.h>
+#include <algine/core/shader/UniformCache.h>
+#include <algine/core/shader/UniformId.h>
 #include <algine/core/shader/ShadersInfo.h>
 #include <algine/core/shader/Shader.h>
 
@@ -17,6 +19,14 @@
 
 namespace algine {
 class ShaderProgram: public Object {
+    friend class Engine;
+
+public:
+    enum TransformFeedbackMode {
+        InterleavedAttribs = 0x8C8C,
+        SeparateAttribs = 0x8C8D
+    };
+
 public:
     ShaderProgram();
     ~ShaderProgram();
@@ -28,6 +38,14 @@ public:
     void attachShader(const Shader &shader);
     void link();
 
+    /**
+     * Specifies outputs captured by transform feedback.
+     * Takes effect on the next <code>link()</code>
+     * @param varyings
+     * @param mode
+     */
+    void setTransformFeedbackVaryings(const std::vector<std::string> &varyings, uint mode = SeparateAttribs);
+
     void loadUniformLocation(const std::string &name);
     void loadUniformLocations(const std::vector<std::string> &names);
     void loadAttribLocation(const std::string &name);
@@ -35,14 +53,35 @@ public:
     void loadActiveLocations();
     int getLocation(const std::string &name);
 
+    /**
+     * Looks up location in the flat table filled by <code>load*Location*</code>
+     * functions, no strings are hashed or compared
+     * @return location or -1 if id is not loaded
+     */
+    int getLocation(UniformId id) const;
+
     void bind();
     void unbind();
+
+    /**
+     * Enables cache of the uniform values: if the program is bound via
+     * <code>bind</code>, setters skip values which are equal to the sent ones.
+     * If uniforms are changed with raw GL calls, cache must be invalidated
+     */
+    void setUniformCacheEnabled(bool enabled);
+    bool isUniformCacheEnabled() const;
+    void invalidateUniformCache();
+
+    /// @return cache or nullptr if disabled
+    const UniformCache* getUniformCache() const;
+
     static void setBool(int location, bool p);
     static void setInt(int location, int p);
     static void setUint(int location, uint p);
     static void setFloat(int location, float p);
     static void setVec3(int location, const glm::vec3 &p);
     static void setVec4(int location, const glm::vec4 &p);
+    static void setVec4(int location, uint count, const glm::vec4 *p);
     static void setMat3(int location, const glm::mat3 &p);
     static void setMat4(int location, const glm::mat4 &p);
 
@@ -52,9 +91,20 @@ public:
     void setFloat(const std::string &location, float p);
     void setVec3(const std::string &location, const glm::vec3 &p);
     void setVec4(const std::string &location, const glm::vec4 &p);
+    void setVec4(const std::string &location, uint count, const glm::vec4 *p);
     void setMat3(const std::string &location, const glm::mat3 &p);
     void setMat4(const std::string &location, const glm::mat4 &p);
 
+    void setBool(UniformId location, bool p);
+    void setInt(UniformId location, int p);
+    void setUint(UniformId location, uint p);
+    void setFloat(UniformId location, float p);
+    void setVec3(UniformId location, const glm::vec3 &p);
+    void setVec4(UniformId location, const glm::vec4 &p);
+    void setVec4(UniformId location, uint count, const glm::vec4 *p);
+    void setMat3(UniformId location, const glm::mat3 &p);
+    void setMat4(UniformId location, const glm::mat4 &p);
+
     uint getId() const;
 
     implementVariadicCreate(ShaderProgram)
@@ -70,6 +120,28 @@ public:
 
 public:
     static std::vector<ShaderProgramPtr> publicObjects;
+
+private:
+    /// @return true if value must be sent to the bound program
+    static bool updateCache(int location, const void *data, uint size);
+
+    void addLocation(const std::string &name, int location);
+
+private:
+    struct IdSlot {
+        uint hash; // 0 if empty
+        int location;
+    };
+
+private:
+    UniformCache *m_uniformCache = nullptr;
+
+    // open addressing, power of two size
+    std::vector<IdSlot> m_idLocations;
+    uint m_idsCount = 0;
+
+private:
+    static ShaderProgram *m_current;
 };
 }
 
@@ -2,6 +2,8 @@
 #define ALGINE_UNIFORMBLOCK_H
 
 #include <algine/core/shader/BaseUniformBlock.h>
+#include <algine/core/buffers/StreamBuffer.h>
+#include <algine/core/buffers/BufferMirror.h>
 
 #include <tulz/Array.h>
 
@@ -47,9 +49,30 @@ public:
     void writeMat3(const std::string &name, const glm::mat3 &p);
     void writeMat4(const std::string &name, const glm::mat4 &p);
 
+    /**
+     * Writes variable to the stream buffer range, which holds this block.
+     * Bind the range with <code>StreamBuffer::bindRange(getBindingPoint(), range)</code>
+     */
+    void write(const StreamBuffer::Range &range, uint position, uint size, const void *data) const;
+
+    /**
+     * If mirror is enabled, writes go to the CPU copy of the block
+     * and are uploaded only by <code>flush</code>. Block must be initialized
+     */
+    void enableMirror();
+    void disableMirror();
+
+    /// uploads changed data, buffer must be bound
+    void flush();
+
+    bool isMirrorEnabled() const;
+    const BufferMirror& getMirror() const;
+
 private:
     tulz::Array<std::string> m_varNames;
     tulz::Array<uint> m_varOffsets;
+    BufferMirror m_mirror;
+    bool m_mirrorEnabled = false;
 };
 }
 
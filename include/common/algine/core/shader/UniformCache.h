@@ -0,0 +1,49 @@
+#ifndef ALGINE_UNIFORMCACHE_H
+#define ALGINE_UNIFORMCACHE_H
+
+#include <algine/types.h>
+
+#include <vector>
+
+namespace algine {
+/**
+ * Last values of the program uniforms, indexed by location.
+ * Values are compared byte by byte, so unchanged values
+ * are not sent again
+ */
+class UniformCache {
+public:
+    /**
+     * Stores value if it differs from the cached one
+     * @return true if value must be sent
+     */
+    bool update(int location, const void *data, uint size);
+
+    /// forgets all values, e.g. after relinking or raw <code>glUniform*</code> calls
+    void invalidate();
+    void invalidate(int location);
+
+    /// @return amount of skipped calls
+    uint getHits() const;
+
+    /// @return amount of sent values
+    uint getMisses() const;
+
+    void resetCounters();
+
+private:
+    struct Entry {
+        uint offset;
+        uint capacity;
+        uint size; // 0 if value is unknown
+    };
+
+private:
+    std::vector<Entry> m_entries;
+    std::vector<byte> m_values;
+    uint m_hits = 0;
+    uint m_misses = 0;
+};
+}
+
+#endif //ALGINE_UNIFORMCACHE_H
@@ -0,0 +1,42 @@
+#ifndef ALGINE_UNIFORMID_H
+#define ALGINE_UNIFORMID_H
+
+#include <algine/types.h>
+
+namespace algine {
+/**
+ * Hashed uniform or attribute name (32-bit FNV-1a), can be
+ * computed at compile time:
+ * <br><code>constexpr UniformId Kernel("kernel[0]");</code>
+ * <br>Constructor is explicit to not conflict with string overloads
+ */
+class UniformId {
+public:
+    constexpr explicit UniformId(const char *name)
+        : m_hash(hash(name)) {}
+
+    constexpr uint getHash() const {
+        return m_hash;
+    }
+
+    constexpr bool operator==(const UniformId &other) const {
+        return m_hash == other.m_hash;
+    }
+
+    static constexpr uint hash(const char *str) {
+        uint value = 2166136261u;
+
+        while (*str != '\0') {
+            value = (value ^ static_cast<uchar>(*str++)) * 16777619u;
+        }
+
+        // 0 marks empty slots of the location tables
+        return value == 0 ? 1 : value;
+    }
+
+private:
+    uint m_hash;
+};
+}
+
+#endif //ALGINE_UNIFORMID_H
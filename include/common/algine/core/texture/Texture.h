@@ -60,6 +60,7 @@ public:
         RG32F = GL_RG32F,
         RGB32F = GL_RGB32F,
         RGBA32F = GL_RGBA32F,
+        RGBA32UI = GL_RGBA32UI,
 
         enable_if_desktop(
             desktop_Red16 = GL_R16,
@@ -95,6 +96,18 @@ public:
     void setHeight(uint height);
     void setDimensions(uint width, uint height);
 
+    /**
+     * Enables immutable storage (<code>glTexStorage2D</code>) if supported.
+     * Storage is allocated once by <code>update</code> or <code>fromFile</code>;
+     * if dimensions or format are changed later, the texture is recreated,
+     * its id changes and parameters are restored. Base formats are
+     * replaced with the corresponding 8-bit sized formats
+     */
+    void setImmutable(bool immutable);
+
+    /// @param count - mip levels of the immutable storage, 0 for the full chain
+    void setMipLevelsCount(uint count);
+
     /// updates width / height, lod, format
     virtual void update() = 0;
 
@@ -103,6 +116,10 @@ public:
     uint getWidth() const;
     uint getHeight() const;
     uint getId() const;
+    uint getMipLevelsCount() const;
+
+    /// @return true if immutable storage is requested and supported
+    bool isImmutable() const;
 
     virtual uint getActualFormat() const = 0;
     virtual uint getActualWidth() const = 0;
@@ -110,6 +127,9 @@ public:
 
     static void activateSlot(uint slot);
 
+    /// requires OpenGL 4.2 / <code>GL_ARB_texture_storage</code> or OpenGL ES 3.0
+    static bool isImmutableStorageSupported();
+
 protected:
     uint m_target = 0; // texture 2d, texture cube etc
     uint m_id = 0;
@@ -117,8 +137,21 @@ protected:
     uint m_format = RGB16F;
     uint m_width = 512, m_height = 512;
 
+protected:
+    bool m_immutable = false;
+    uint m_mipLevels = 0;
+    uint m_storageFormat = 0;
+    uint m_storageWidth = 0, m_storageHeight = 0;
+
 protected:
     explicit Texture(uint target);
+
+    /**
+     * Allocates immutable storage if needed, texture must be bound
+     * @return false if mutable storage must be used
+     */
+    bool allocateStorage();
+
     void texFromFile(const std::string &path, uint target, DataType dataType = DataType::UnsignedByte, bool flipImage = true);
 };
 }
@@ -0,0 +1,53 @@
+#ifndef ALGINE_TEXTUREBUFFER_H
+#define ALGINE_TEXTUREBUFFER_H
+
+#include <algine/core/texture/Texture.h>
+#include <algine/core/buffers/Buffer.h>
+#include <algine/templates.h>
+#include <algine/types.h>
+#include <algine/gl.h>
+
+#ifndef GL_TEXTURE_BUFFER
+    // GLES < 3.2 headers, the value is the same as GL_TEXTURE_BUFFER_EXT
+    #define GL_TEXTURE_BUFFER 0x8C2A
+#endif
+
+namespace algine {
+/**
+ * Buffer texture: exposes the contents of a Buffer to shaders as
+ * a one-dimensional array of texels (<code>samplerBuffer</code>).
+ * Requires OpenGL 3.1 or OpenGL ES 3.2 (Android API 24)
+ */
+class TextureBuffer: public Texture {
+public:
+    constexpr static uint Target = GL_TEXTURE_BUFFER;
+
+public:
+    TextureBuffer();
+
+    /**
+     * Attaches buffer storage, texture must be bound
+     * @param buffer
+     */
+    void setBuffer(Buffer *buffer);
+
+    /// reattaches buffer with the current format
+    void update() override;
+
+    Buffer* getBuffer() const;
+
+    uint getActualFormat() const override;
+    uint getActualWidth() const override;
+    uint getActualHeight() const override;
+
+    static uint getTexelSize(uint format);
+
+    implementVariadicCreate(TextureBuffer)
+    implementVariadicDestroy(TextureBuffer)
+
+private:
+    Buffer *m_buffer = nullptr;
+};
+}
+
+#endif //ALGINE_TEXTUREBUFFER_H
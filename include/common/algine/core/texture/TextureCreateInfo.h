@@ -9,6 +9,7 @@ struct TextureCreateInfo {
     uint lod = 0;
     uint format = 0;
     uint width = 0, height = 0;
+    bool immutable = false;
     std::map<uint, uint> params;
 };
 }
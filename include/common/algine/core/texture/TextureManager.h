@@ -19,12 +19,14 @@ public:
 
     void setType(Type type);
     void setDataType(DataType dataType);
+    void setImmutable(bool immutable);
 
     void setParams(const std::map<uint, uint> &params);
     void setDefaultParams(const std::map<uint, uint> &defaultParams);
 
     Type getType() const;
     DataType getDataType() const;
+    bool isImmutable() const;
 
     const std::map<uint, uint>& getParams() const;
     const std::map<uint, uint>& getDefaultParams() const;
@@ -35,6 +37,7 @@ public:
 protected:
     Type m_type;
     DataType m_dataType;
+    bool m_immutable = false;
     std::map<uint, uint> m_params;
 
 protected:
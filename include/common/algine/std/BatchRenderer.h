@@ -0,0 +1,139 @@
+#ifndef ALGINE_BATCHRENDERER_H
+#define ALGINE_BATCHRENDERER_H
+
+#include <algine/core/buffers/ArrayBuffer.h>
+#include <algine/core/buffers/IndirectBuffer.h>
+#include <algine/core/texture/TextureBuffer.h>
+#include <algine/core/shader/ShaderProgram.h>
+#include <algine/core/InputLayout.h>
+#include <algine/std/model/Model.h>
+#include <algine/std/Material.h>
+#include <algine/types.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+namespace algine {
+/**
+ * Collects meshes between <code>begin</code> and <code>end</code> and
+ * draws all meshes which share the same input layout with one
+ * <code>glMultiDrawElementsIndirect</code> call. Transformations and
+ * material indices are stored in texture buffers and fetched by the draw id
+ * in <code>modules/BatchRenderer.glsl</code>. If multi-draw is not supported,
+ * commands are issued one by one with the same data.
+ * Material textures are not bound, they must be resolved by the shader
+ */
+class BatchRenderer {
+public:
+    /// layout of <code>DrawElementsIndirectCommand</code>
+    struct DrawCommand {
+        uint count;
+        uint instanceCount;
+        uint firstIndex;
+        int baseVertex;
+        uint baseInstance;
+    };
+
+    enum class Mode {
+        MultiDrawIndirect,
+        Loop
+    };
+
+public:
+    BatchRenderer();
+    ~BatchRenderer();
+
+    void begin();
+
+    /**
+     * Adds all meshes of the model shape
+     * @param model
+     * @param inputLayoutIndex - index of the shape input layout
+     */
+    void add(Model *model, Index inputLayoutIndex = 0);
+
+    /**
+     * Adds mesh
+     * @param inputLayout - input layout with the index buffer
+     * @param start - first index
+     * @param count - indices count
+     * @param transform
+     * @param materialIndex - value returned by <code>addMaterial</code>
+     */
+    void add(InputLayout *inputLayout, uint start, uint count, const glm::mat4 &transform, Index materialIndex);
+
+    /// uploads commands and per-draw data
+    void end();
+
+    /**
+     * Draws collected meshes, program must be bound.
+     * Binds draws and materials to <code>textureSlot</code>
+     * and <code>textureSlot + 1</code>
+     */
+    void draw(ShaderProgram *program, uint textureSlot);
+
+    /**
+     * Adds material or returns index of the already added material
+     * with the same name
+     */
+    Index addMaterial(const Material &material);
+
+    /**
+     * <code>ALGINE_BATCH_DRAW_PARAMETERS</code> must be defined
+     * in the shader if mode is <code>MultiDrawIndirect</code>
+     * @param mode - if multi-draw is not supported, <code>Loop</code> is used
+     */
+    void setMode(Mode mode);
+
+    Mode getMode() const;
+    uint getDrawsCount() const;
+    uint getBatchesCount() const;
+    uint getMaterialsCount() const;
+
+    /// @return draw calls issued by the last <code>draw</code>
+    uint getDrawCallsCount() const;
+
+    /// requires OpenGL 4.3 and <code>GL_ARB_shader_draw_parameters</code>
+    static bool isMultiDrawSupported();
+
+private:
+    struct Draw {
+        Index batch;
+        uint start;
+        uint count;
+        Index material;
+        glm::mat4 transform;
+    };
+
+    struct Batch {
+        InputLayout *inputLayout;
+        uint firstDraw;
+        uint drawsCount;
+    };
+
+private:
+    Mode m_mode = Mode::Loop;
+    std::vector<Draw> m_draws;
+    std::vector<Batch> m_batches;
+    std::unordered_map<const InputLayout*, Index> m_batchIndices;
+    std::vector<DrawCommand> m_commands;
+    std::vector<glm::vec4> m_drawsData;
+    std::vector<glm::vec4> m_materials;
+    std::unordered_map<std::string, Index> m_materialIndices;
+    bool m_materialsChanged = false;
+    uint m_drawCallsCount = 0;
+
+private:
+    IndirectBuffer *m_commandsBuffer;
+    ArrayBuffer *m_drawsBuffer;
+    ArrayBuffer *m_materialsBuffer;
+    TextureBuffer *m_drawsTexture;
+    TextureBuffer *m_materialsTexture;
+};
+}
+
+#endif //ALGINE_BATCHRENDERER_H
@@ -3,6 +3,7 @@
 
 #include <algine/std/animation/VecAnimKey.h>
 #include <algine/std/animation/QuatAnimKey.h>
+#include <algine/std/animation/CompressedAnimNode.h>
 
 #include <string>
 #include <vector>
@@ -18,6 +19,7 @@ public:
     std::string name;
     std::vector<VecAnimKey> scalingKeys, positionKeys;
     std::vector<QuatAnimKey> rotationKeys;
+    CompressedAnimNode compressed;
 };
 }
 
@@ -2,6 +2,7 @@
 #define ALGINE_ANIMATION_H
 
 #include <algine/std/animation/AnimNode.h>
+#include <algine/std/animation/MorphAnimNode.h>
 
 #include <string>
 #include <vector>
@@ -13,10 +14,17 @@ class Animation {
 public:
     explicit Animation(const aiAnimation *anim);
 
+    bool isCompressed() const;
+
 public:
     double ticksPerSecond, duration;
     std::string name;
     std::vector<AnimNode> channels;
+    std::vector<MorphAnimNode> morphChannels;
+
+    // compressed form, see AnimationCompressor
+    float frameStep = 0.0f; // frame duration in ticks; 0 if the animation is not compressed
+    CompressedAnimNode::Range positionRange, scalingRange;
 };
 }
 
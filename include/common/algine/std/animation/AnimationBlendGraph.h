@@ -0,0 +1,78 @@
+#ifndef ALGINE_ANIMATIONBLENDGRAPH_H
+#define ALGINE_ANIMATIONBLENDGRAPH_H
+
+#include <algine/std/animation/BoneMatrices.h>
+#include <algine/std/animation/LocalPose.h>
+#include <algine/std/animation/BoneMask.h>
+#include <algine/std/model/ModelPtr.h>
+#include <algine/types.h>
+
+#include <vector>
+
+namespace algine {
+/**
+ * Blends any number of animations of the model in local (joint) space.
+ * Layers are applied in order on top of the default pose, then the hierarchy
+ * is walked once to produce bone matrices. Use it with
+ * <code>model->setBones(&graph.bones())</code>
+ */
+class AnimationBlendGraph {
+public:
+    enum class BlendMode {
+        Lerp,    ///< result = mix(result, layer, weight)
+        Additive ///< result += (layer - reference) * weight
+    };
+
+    struct Layer {
+        Index animationIndex = 0;
+        BlendMode mode = BlendMode::Lerp;
+        float weight = 1.0f;
+        float speed = 1.0f;
+        float timeOffset = 0.0f;
+
+        /// joint mask, empty mask affects all joints
+        BoneMask mask;
+
+        /// additive layers only: the layer is applied relative to this pose
+        Index referenceAnimation = 0;
+        float referenceTime = 0.0f;
+    };
+
+public:
+    explicit AnimationBlendGraph(const ModelPtr &model);
+    AnimationBlendGraph();
+
+    /**
+     * Samples all layers with non-zero weight and updates bones
+     * @param timeInSeconds
+     */
+    void evaluate(float timeInSeconds);
+
+    Index addLayer(const Layer &layer);
+    void setLayer(Index index, const Layer &layer);
+    void setLayerWeight(Index index, float weight);
+    void removeLayer(Index index);
+    void removeLayers();
+
+    void setModel(const ModelPtr &model);
+
+    const Layer& getLayer(Index index) const;
+    uint getLayersCount() const;
+    const ModelPtr& getModel() const;
+    const LocalPose& getPose() const;
+    const BoneMatrices& bones() const;
+
+private:
+    const LocalPose& getReferencePose(Index layerIndex);
+
+private:
+    ModelPtr m_model = nullptr;
+    std::vector<Layer> m_layers;
+    std::vector<LocalPose> m_referencePoses;
+    LocalPose m_pose, m_layerPose;
+    std::vector<glm::mat4> m_globals;
+    BoneMatrices m_bones;
+};
+}
+
+#endif //ALGINE_ANIMATIONBLENDGRAPH_H
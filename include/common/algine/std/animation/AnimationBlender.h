@@ -1,14 +1,22 @@
 #ifndef ALGINE_ANIMATIONBLENDER_H
 #define ALGINE_ANIMATIONBLENDER_H
 
+#include <algine/std/animation/AnimationBlendGraph.h>
 #include <algine/std/model/ModelPtr.h>
 #include <algine/types.h>
 
-#include <glm/mat4x4.hpp>
-
 #include <vector>
 
 namespace algine {
+/**
+ * Blends two animations of the model. It is a two-layer AnimationBlendGraph:
+ * joints are blended in local space (translation, rotation and scale), so
+ * the result is a valid pose for any factor. For more animations or additive
+ * layers use AnimationBlendGraph directly
+ * <br>Blend list contains bone indices; in Include mode only the listed bones
+ * are blended, in Exclude mode all except them. Since blending is done in local
+ * space, children of the listed bones follow them
+ */
 class AnimationBlender {
 public:
     enum BlendListModes {
@@ -21,8 +29,13 @@ public:
     explicit AnimationBlender(const ModelPtr &model);
     AnimationBlender();
 
-    void blend();
-    void initInverseBoneMatrices();
+    /**
+     * Samples both animations and blends them; skipped if blend parameters,
+     * time and bone transformations have not changed since the previous call.
+     * Result is available via <code>bones()</code>
+     * @param timeInSeconds
+     */
+    void blend(float timeInSeconds);
 
     void addBlendListItem(uint item);
     void setBlendListMode(uint mode);
@@ -39,20 +52,31 @@ public:
     uint getRhsAnim() const;
     float getFactor() const;
     const ModelPtr& getModel() const;
-    const std::vector<glm::mat4>& bones();
+    const BoneMatrices& bones() const;
+
+    /// @return amount of skipped blends of all blenders, for profiling
+    static uint getSkippedEvaluations();
+    static void resetSkippedEvaluations();
 
 private:
-    glm::mat4 blendBones(uint index) const;
+    void updateLayers();
+    BoneMask getBlendMask() const;
 
 private:
+    AnimationBlendGraph m_graph;
     std::vector<uint> m_blendList;
-    std::vector<glm::mat4> m_bones;
-    std::vector<glm::mat4> m_inverseBoneMatrices;
-    glm::mat4 inverseGlobalInverseTransform;
     uint m_blendListMode = BlendListDisable;
     uint m_lhsAnim = 0, m_rhsAnim = 0;
     ModelPtr m_model = nullptr;
     float m_factor = 0.0f;
+
+private:
+    bool m_changed = true;
+    float m_lastTime = -1.0f;
+    uint m_lastTransformationsVersion = 0;
+
+private:
+    static uint m_skippedEvaluations;
 };
 }
 
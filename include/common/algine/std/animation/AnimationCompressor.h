@@ -0,0 +1,43 @@
+#ifndef ALGINE_ANIMATIONCOMPRESSOR_H
+#define ALGINE_ANIMATIONCOMPRESSOR_H
+
+#include <algine/std/animation/Animation.h>
+
+namespace algine {
+class AnimationCompressor {
+public:
+    struct Info {
+        usize originalSize = 0;
+        usize compressedSize = 0;
+        float ratio = 1.0f;
+        float maxPositionError = 0.0f;
+        float maxRotationError = 0.0f; // in radians
+        float maxScalingError = 0.0f;
+    };
+
+public:
+    /**
+     * Removes keys that can be restored by interpolation within the
+     * tolerances, quantizes the rest and replaces the source keys
+     * with the compressed ones
+     * @param animation
+     * @return compression ratio and max error measured on the source keys
+     */
+    Info compress(Animation &animation) const;
+
+    void setPositionTolerance(float tolerance);
+    void setRotationTolerance(float tolerance);
+    void setScalingTolerance(float tolerance);
+
+    float getPositionTolerance() const;
+    float getRotationTolerance() const;
+    float getScalingTolerance() const;
+
+private:
+    float m_positionTolerance = 0.001f;
+    float m_rotationTolerance = 0.001f; // in radians
+    float m_scalingTolerance = 0.001f;
+};
+}
+
+#endif //ALGINE_ANIMATIONCOMPRESSOR_H
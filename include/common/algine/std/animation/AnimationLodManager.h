@@ -0,0 +1,108 @@
+#ifndef ALGINE_ANIMATIONLODMANAGER_H
+#define ALGINE_ANIMATIONLODMANAGER_H
+
+#include <algine/std/animation/BoneMatrices.h>
+#include <algine/std/animation/LocalPose.h>
+#include <algine/std/animation/BoneMask.h>
+#include <algine/std/model/ModelPtr.h>
+#include <algine/types.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <unordered_map>
+#include <vector>
+#include <list>
+
+namespace algine {
+class Shape;
+
+/**
+ * Animates models with a detail level chosen by their projected screen size.
+ * Far models are animated every N-th frame (updates are staggered between
+ * models) and their bones are interpolated between two last updates, so they
+ * lag one update interval behind. Optionally, leaf joints of far models are
+ * frozen. Bone budget limits the amount of bones evaluated per frame:
+ * models are served by descending <code>screenSize * (framesSinceUpdate + 1)</code>,
+ * so the farthest models are throttled first, but never starve
+ */
+class AnimationLodManager {
+public:
+    struct Level {
+        float minScreenSize = 0.0f; ///< projected height / viewport height
+        uint updateInterval = 1;    ///< in frames
+        bool freezeLeafJoints = false;
+    };
+
+public:
+    AnimationLodManager();
+
+    /**
+     * @param model - model with animator
+     * @param boundingRadius - radius of the model bounding sphere in world space
+     */
+    void addModel(const ModelPtr &model, float boundingRadius);
+
+    /**
+     * Removes model from the manager, model bones will be reset to nullptr
+     */
+    void removeModel(const ModelPtr &model);
+
+    /**
+     * Updates detail levels and animates models; model bones
+     * are set to the manager owned matrices
+     * @param view - camera view matrix
+     * @param projection - camera projection matrix
+     * @param timeInSeconds
+     */
+    void update(const glm::mat4 &view, const glm::mat4 &projection, float timeInSeconds);
+
+    /**
+     * @param levels - levels sorted by descending <code>minScreenSize</code>,
+     * the last one is used for all smaller models
+     */
+    void setLevels(const std::vector<Level> &levels);
+
+    /// @param budget - max bones evaluated per frame, 0 - unlimited
+    void setBoneBudget(uint budget);
+
+    const std::vector<Level>& getLevels() const;
+    uint getBoneBudget() const;
+    Index getLevel(const ModelPtr &model) const;
+    float getScreenSize(const ModelPtr &model) const;
+
+    /// @return bones evaluated during the last update
+    uint getEvaluatedBones() const;
+
+private:
+    struct Entry {
+        ModelPtr model;
+        float boundingRadius = 0.0f;
+        float screenSize = 0.0f;
+        Index level = 0;
+        uint phase = 0;
+        uint framesSinceUpdate = 0;
+        bool initialized = false;
+        LocalPose pose;
+        std::vector<glm::mat4> globals;
+        BoneMatrices previous, current, bones;
+    };
+
+private:
+    const Entry& getEntry(const ModelPtr &model) const;
+    const BoneMask& getLeafJoints(Shape *shape);
+    void animate(Entry &entry, float timeInSeconds);
+
+private:
+    // models point to the entry matrices, so entries must not move
+    std::list<Entry> m_entries;
+    std::vector<Level> m_levels;
+    std::vector<Entry*> m_due;
+    std::unordered_map<Shape*, BoneMask> m_leafJoints;
+    uint m_boneBudget = 0;
+    uint m_evaluatedBones = 0;
+    uint m_frame = 0;
+    uint m_nextPhase = 0;
+};
+}
+
+#endif //ALGINE_ANIMATIONLODMANAGER_H
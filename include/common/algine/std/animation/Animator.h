@@ -1,11 +1,14 @@
 #ifndef ALGINE_ANIMATOR_H
 #define ALGINE_ANIMATOR_H
 
-#include <algine/std/Node.h>
+#include <algine/std/animation/LocalPose.h>
+#include <algine/std/animation/BoneMatrices.h>
+#include <algine/std/animation/BoneMask.h>
 #include <algine/types.h>
 
 namespace algine {
 class Model;
+class Shape;
 
 class Animator {
 public:
@@ -13,8 +16,45 @@ public:
     Animator(Model *model, const std::string &animationName);
     explicit Animator(Model *model, Index animationIndex = 0);
 
+    /**
+     * Evaluates bones of the current animation. Evaluation is skipped
+     * if animation time, animation and bone transformations have not
+     * changed since the previous call
+     */
     void animate(float timeInSeconds);
 
+    /**
+     * Samples local transformations of all skeleton joints,
+     * joints without animation channel get their default transformation
+     */
+    void samplePose(float timeInSeconds, LocalPose &out) const;
+
+    /**
+     * @param frozenJoints - if not null, masked joints keep their current
+     * transformations in <code>out</code> and are not sampled
+     */
+    static void samplePose(const Shape &shape, Index animationIndex, float timeInSeconds, LocalPose &out,
+                           const BoneMask *frozenJoints = nullptr);
+
+    /**
+     * Walks the skeleton once and writes final bone matrices
+     * @param shape
+     * @param pose - local pose of the shape skeleton
+     * @param boneTransformations - additional bone transformations, see <code>Model::setBoneTransform</code>
+     * @param globals - scratch storage for the global joint transformations
+     * @param out - must have bones amount size
+     */
+    static void computeBones(const Shape &shape, const LocalPose &pose, const BoneMatrices &boneTransformations,
+                             std::vector<glm::mat4> &globals, BoneMatrices &out);
+
+    /**
+     * Samples morph channels of the animation
+     * @param out - weights of all shape morph targets, targets
+     * without channel get zero weight
+     */
+    static void sampleMorphWeights(const Shape &shape, Index animationIndex, float timeInSeconds,
+                                   std::vector<float> &out);
+
     void setModel(Model *model);
     void setAnimationIndex(Index animationIndex);
     void setAnimation(const std::string &name);
@@ -22,12 +62,25 @@ public:
     Model* getModel() const;
     Index getAnimationIndex() const;
 
-private:
-    void readNodeHierarchy(float animationTime, const Node &node, const glm::mat4 &parentTransform);
+    /// @return amount of skipped evaluations of all animators, for profiling
+    static uint getSkippedEvaluations();
+    static void resetSkippedEvaluations();
 
 private:
     Model *m_model = nullptr;
     Index m_animationIndex = 0;
+    LocalPose m_pose;
+    std::vector<glm::mat4> m_globals;
+
+private:
+    float m_lastAnimationTime = -1.0f;
+    Index m_lastAnimationIndex = 0;
+    uint m_lastTransformationsVersion = 0;
+    const BoneMatrix *m_lastBones = nullptr;
+    uint m_lastBonesGeneration = 0; // pose pool slots are recycled
+
+private:
+    static uint m_skippedEvaluations;
 };
 }
 
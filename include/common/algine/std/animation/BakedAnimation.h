@@ -0,0 +1,69 @@
+#ifndef ALGINE_BAKEDANIMATION_H
+#define ALGINE_BAKEDANIMATION_H
+
+#include <algine/std/animation/BoneMatrices.h>
+#include <algine/std/model/ShapePtr.h>
+
+#include <algine/core/texture/Texture2DPtr.h>
+#include <algine/core/shader/ShaderProgram.h>
+#include <algine/types.h>
+
+namespace algine {
+/**
+ * Animation sampled at a fixed rate into a contiguous palette table:
+ * frame <code>i</code> occupies bones <code>[i * bonesCount, (i + 1) * bonesCount)</code>.
+ * Baked animations are looped, the last frame is interpolated with the first one
+ */
+class BakedAnimation {
+public:
+    struct Pose {
+        Index frame = 0;
+        Index nextFrame = 0;
+        float factor = 0.0f;
+    };
+
+public:
+    BakedAnimation();
+    BakedAnimation(const ShapePtr &shape, Index animationIndex, float sampleRate = 30.0f);
+
+    void bake(const ShapePtr &shape, Index animationIndex, float sampleRate = 30.0f);
+
+    /**
+     * Creates RGBA32F texture with (bonesCount * 4) x framesCount size,
+     * each texel row holds one frame. Use it with
+     * <code>ALGINE_BAKED_ANIMATION</code> BoneSystem mode
+     */
+    void createTexture();
+
+    Pose getPose(float timeInSeconds, float phaseOffset = 0.0f) const;
+
+    void sample(const Pose &pose, BoneMatrices &out) const;
+    void sample(float timeInSeconds, float phaseOffset, BoneMatrices &out) const;
+
+    /**
+     * Binds texture to the specified slot and sets <code>bakedBones</code>
+     * and <code>bakedPose</code> uniforms; program must be bound
+     */
+    void setUniforms(ShaderProgram *program, const Pose &pose, uint textureSlot) const;
+
+    const BoneMatrix* getFrame(Index frame) const;
+    const BoneMatrices& getFrames() const;
+    const Texture2DPtr& getTexture() const;
+    Index getAnimationIndex() const;
+    uint getFramesCount() const;
+    uint getBonesCount() const;
+    float getSampleRate() const;
+    float getDuration() const;
+
+private:
+    BoneMatrices m_frames;
+    Texture2DPtr m_texture;
+    Index m_animationIndex = 0;
+    uint m_framesCount = 0;
+    uint m_bonesCount = 0;
+    float m_sampleRate = 0.0f;
+    float m_duration = 0.0f;
+};
+}
+
+#endif //ALGINE_BAKEDANIMATION_H
@@ -0,0 +1,44 @@
+#ifndef ALGINE_BONEMASK_H
+#define ALGINE_BONEMASK_H
+
+#include <algine/types.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace algine {
+class Skeleton;
+
+/**
+ * Bitset of skeleton joints (or bones), one bit per index
+ */
+class BoneMask {
+public:
+    BoneMask();
+    explicit BoneMask(uint size, bool value = false);
+
+    void resize(uint size, bool value = false);
+    void set(Index index, bool value = true);
+    void setAll(bool value);
+    void invert();
+
+    bool test(Index index) const;
+    uint size() const;
+    bool empty() const;
+
+    /**
+     * Creates joint mask of the specified nodes
+     * @param skeleton
+     * @param names
+     * @param includeChildren - whether to include the whole subtree of each node
+     */
+    static BoneMask fromJoints(const Skeleton &skeleton, const std::vector<std::string> &names, bool includeChildren = true);
+
+private:
+    std::vector<std::uint64_t> m_words;
+    uint m_size = 0;
+};
+}
+
+#endif //ALGINE_BONEMASK_H
@@ -3,19 +3,80 @@
 
 #include <algine/core/shader/UniformBlock.h>
 #include <algine/core/buffers/BlockBufferStorage.h>
+#include <algine/core/buffers/ArrayBuffer.h>
+#include <algine/core/texture/TextureBuffer.h>
 
+#include <algine/std/animation/BoneMatrices.h>
 #include <algine/std/model/ModelPtr.h>
 
+#include <glm/mat4x4.hpp>
+
 #include <unordered_map>
+#include <functional>
+#include <map>
 
 namespace algine {
 class BoneSystemManager {
 public:
+    /**
+     * UniformBlock: one fixed-size <code>BoneSystem</code> block per model,
+     * bones count is limited by <code>MAX_BONES</code>
+     * <br>Palette: bones of all models are packed into one texture buffer,
+     * each model takes as many matrices as it has bones. Shaders must be
+     * compiled with <code>ALGINE_BONE_SYSTEM_PALETTE</code> and models
+     * must be linked via <code>linkBuffer(model, program)</code>
+     */
+    enum class Mode {
+        UniformBlock,
+        Palette
+    };
+
+    /**
+     * Matrix: mat4 per bone
+     * <br>DualQuaternion: 2 vec4 per bone (real and dual parts), bones are treated
+     * as rigid transformations. Shaders must be compiled with
+     * <code>ALGINE_DUAL_QUATERNION_SKINNING</code>
+     * <br>ScaledDualQuaternion: dual quaternion and uniform scale per bone.
+     * Shaders must be compiled with <code>ALGINE_DUAL_QUATERNION_SKINNING</code>
+     * and <code>ALGINE_DUAL_QUATERNION_SCALE</code>
+     */
+    enum class BoneFormat {
+        Matrix,
+        DualQuaternion,
+        ScaledDualQuaternion
+    };
+
+public:
+    ~BoneSystemManager();
+
     void init();
     void writeBonesForAll();
     void writeBones(const ModelPtr &model);
     void linkBuffer(const ModelPtr &model);
+    void linkBuffer(const ModelPtr &model, ShaderProgram *program);
     void setupBones(const ModelPtr &model);
+    void setupBones(const ModelPtr &model, ShaderProgram *program);
+
+    /**
+     * Writes model block into the stream buffer and links it,
+     * UniformBlock mode only. Block is written every call, so use it
+     * for the models which bones change every frame
+     */
+    void setupBones(const ModelPtr &model, StreamBuffer &stream);
+
+    /**
+     * Moves model blocks to the beginning of the storage and shrinks it,
+     * UniformBlock mode only. Call it after removing many models
+     */
+    void compactStorage();
+
+    /// binds palette texture buffer to the palette slot
+    void bindPalette() const;
+
+    void setMode(Mode mode);
+    /// must be called before <code>init</code>
+    void setBoneFormat(BoneFormat format);
+    void setPaletteSlot(uint slot);
 
     void setMaxModelsCount(uint count);
     void setBindingPoint(uint bindingPoint);
@@ -27,23 +88,78 @@ public:
     void removeModel(const ModelPtr &model);
     void removeModels(const std::vector<ModelPtr> &models);
 
+    Mode getMode() const;
+    BoneFormat getBoneFormat() const;
+    uint getPaletteSlot() const;
     uint getBindingPoint() const;
     const std::vector<ShaderProgramPtr>& getShaderPrograms() const;
     const UniformBlock& getUniformBlock() const;
     const BlockBufferStorage& getBlockBufferStorage() const;
+    TextureBuffer* getPalette() const;
+
+    /// @return amount of bone uploads skipped because bones had not changed, for profiling
+    uint getSkippedUploads() const;
+    void resetSkippedUploads();
 
     static uint getAttribsCount(uint bonesPerVertex);
 
+    /**
+     * Converts bone matrix to the dual quaternion
+     * @param bone
+     * @param real - [out] rotation, xyzw
+     * @param dual - [out] translation part, xyzw
+     * @return uniform scale of the bone
+     */
+    static float toDualQuaternion(const glm::mat4 &bone, glm::vec4 &real, glm::vec4 &dual);
+
 private:
     void writeBones(const ModelPtr &model, Index index);
+
+    /// @param write - writes data to the block variable: (position, size, data)
+    void writeBones(const ModelPtr &model, const std::function<void(uint, uint, const void*)> &write);
     void linkUniformBuffer(Index blockIndex);
+    uint getLinkedId(const ModelPtr &model);
+
+    /// @return true if bones were changed since the last write, marks them as written
+    bool isBonesChanged(const ModelPtr &model);
+
+    Index allocatePaletteRange(uint size);
+    void freePaletteRange(Index offset, uint size);
+    void writePaletteBones(const ModelPtr &model, Index offset);
+    void uploadPalette();
+    uint getTexelsPerBone() const;
 
 private:
     std::vector<ShaderProgramPtr> m_programs;
-    std::unordered_map<ModelPtr, uint> m_ids;
+    std::unordered_map<ModelPtr, uint> m_ids; // block index or palette offset
+    std::unordered_map<ModelPtr, uint> m_sharedIds; // models that use bones written for another model
+    std::unordered_map<const BoneMatrices*, ModelPtr> m_writtenBones;
+
+private:
+    struct WrittenVersion {
+        const BoneMatrices *bones;
+        uint version;
+    };
+
+    std::unordered_map<ModelPtr, WrittenVersion> m_writtenVersions;
+    uint m_skippedUploads = 0;
     BlockBufferStorage m_bufferStorage;
     UniformBlock m_uniformBlock;
-    uint m_bonesPos, m_boneAttribsCountPos, m_linkedBlock = -1;
+    uint m_bonesPos, m_boneScalesPos, m_boneAttribsCountPos, m_linkedBlock = -1;
+    BoneFormat m_boneFormat = BoneFormat::Matrix;
+    std::vector<glm::vec4> m_dualQuaternions;
+    std::vector<float> m_boneScales;
+
+private:
+    Mode m_mode = Mode::UniformBlock;
+    std::vector<glm::vec4> m_palette; // cpu copy of the palette buffer, getTexelsPerBone() texels per bone
+    std::map<Index, uint> m_paletteFreeRanges; // offset -> size, in bones
+    uint m_paletteSize = 0; // in bones
+    ArrayBuffer *m_paletteBuffer = nullptr;
+    TextureBuffer *m_paletteTexture = nullptr;
+    uint m_paletteSlot = 0;
+    bool m_paletteResized = false;
+    bool m_paletteChanged = false;
 };
 }
 
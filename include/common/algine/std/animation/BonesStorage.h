@@ -23,6 +23,7 @@ public:
     bool isExists(const std::string &name) const;
 
     Bone& operator[](Index index);
+    const Bone& operator[](Index index) const;
 
     std::vector<Bone>& data();
 
@@ -0,0 +1,51 @@
+#ifndef ALGINE_COMPRESSEDANIMNODE_H
+#define ALGINE_COMPRESSEDANIMNODE_H
+
+#include <algine/types.h>
+
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <vector>
+
+namespace algine {
+/**
+ * Quantized form of AnimNode, filled by AnimationCompressor.
+ * Key times are stored as uint16 frame indices (see Animation::frameStep),
+ * positions and scales as uint16 triples normalized to the clip range,
+ * rotations as smallest-three quaternions (2 + 3 * 15 bits)
+ */
+class CompressedAnimNode {
+public:
+    struct Key {
+        uint16 frame;
+        uint16 value[3];
+    };
+
+    class Range {
+    public:
+        void encode(const glm::vec3 &value, uint16 out[3]) const;
+        glm::vec3 decode(const uint16 value[3]) const;
+
+    public:
+        glm::vec3 min {0.0f};
+        glm::vec3 extent {0.0f};
+    };
+
+public:
+    glm::vec3 samplePosition(float frame, const Range &range) const;
+    glm::vec3 sampleScaling(float frame, const Range &range) const;
+    glm::quat sampleRotation(float frame) const;
+
+    usize getSizeInBytes() const;
+    bool empty() const;
+
+    static void encodeRotation(const glm::quat &rotation, uint16 out[3]);
+    static glm::quat decodeRotation(const uint16 value[3]);
+
+public:
+    std::vector<Key> scalingKeys, positionKeys, rotationKeys;
+};
+}
+
+#endif //ALGINE_COMPRESSEDANIMNODE_H
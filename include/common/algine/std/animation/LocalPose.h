@@ -0,0 +1,35 @@
+#ifndef ALGINE_LOCALPOSE_H
+#define ALGINE_LOCALPOSE_H
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <vector>
+
+namespace algine {
+/**
+ * Node transformation relative to its parent, stored as
+ * translation / rotation / scale so it can be blended without decomposition
+ */
+struct JointTransform {
+    glm::vec3 translation = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+
+    glm::mat4 toMat4() const;
+
+    static JointTransform lerp(const JointTransform &lhs, const JointTransform &rhs, float factor);
+
+    /**
+     * Applies <code>(pose - reference) * factor</code> on top of <code>base</code>
+     */
+    static JointTransform add(const JointTransform &base, const JointTransform &pose,
+                              const JointTransform &reference, float factor);
+};
+
+/// local transformations of the skeleton joints, indexed by joint
+using LocalPose = std::vector<JointTransform>;
+}
+
+#endif //ALGINE_LOCALPOSE_H
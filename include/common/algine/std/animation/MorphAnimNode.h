@@ -0,0 +1,36 @@
+#ifndef ALGINE_MORPHANIMNODE_H
+#define ALGINE_MORPHANIMNODE_H
+
+#include <algine/types.h>
+
+#include <string>
+#include <vector>
+
+class aiMeshMorphAnim;
+
+namespace algine {
+/**
+ * Morph target weights channel of one mesh
+ */
+class MorphAnimNode {
+public:
+    struct Key {
+        double time;
+        std::vector<Index> targets; // target indices in the mesh
+        std::vector<float> weights;
+    };
+
+public:
+    explicit MorphAnimNode(const aiMeshMorphAnim *morphAnim);
+
+public:
+    std::string name; // mesh or node name, depends on the importer
+
+    /// names of the affected meshes, resolved by ShapeManager
+    std::vector<std::string> meshNames;
+
+    std::vector<Key> keys;
+};
+}
+
+#endif //ALGINE_MORPHANIMNODE_H
@@ -0,0 +1,57 @@
+#ifndef ALGINE_POSEPOOL_H
+#define ALGINE_POSEPOOL_H
+
+#include <algine/std/animation/BoneMatrices.h>
+#include <algine/std/animation/PosePoolPtr.h>
+#include <algine/types.h>
+
+#include <unordered_map>
+#include <vector>
+#include <deque>
+
+namespace algine {
+/**
+ * Storage of bone palettes shared between models. Models check out
+ * slots only for animations they actually use; released slots are
+ * recycled through per-size free lists. Slot storage never moves,
+ * so pointers to the slot bones stay valid until the pool is destroyed
+ */
+class PosePool {
+public:
+    typedef Index Slot;
+
+    constexpr static Slot InvalidSlot = -1;
+
+public:
+    Slot acquire(uint bonesCount);
+    void release(Slot slot);
+
+    BoneMatrices& get(Slot slot);
+    const BoneMatrices& get(Slot slot) const;
+
+    /**
+     * @return value that changes each time the slot is acquired, so
+     * a recycled slot can be told apart from the one it replaces
+     */
+    uint getGeneration(Slot slot) const;
+
+    /// @return total amount of slots, including free ones
+    uint getSlotsCount() const;
+    uint getFreeSlotsCount() const;
+
+public:
+    /**
+     * @return pool used by models by default
+     */
+    static const PosePoolPtr& getDefault();
+
+private:
+    std::deque<BoneMatrices> m_slots;
+    std::vector<uint> m_generations;
+    uint m_generation = 0;
+    std::unordered_map<uint, std::vector<Slot>> m_freeSlots;
+    uint m_freeSlotsCount = 0;
+};
+}
+
+#endif //ALGINE_POSEPOOL_H
@@ -0,0 +1,12 @@
+#ifndef ALGINE_POSEPOOLPTR_H
+#define ALGINE_POSEPOOLPTR_H
+
+#include <algine/core/Ptr.h>
+
+namespace algine {
+class PosePool;
+
+typedef Ptr<PosePool> PosePoolPtr;
+}
+
+#endif //ALGINE_POSEPOOLPTR_H
@@ -0,0 +1,73 @@
+#ifndef ALGINE_SHAREDPOSECACHE_H
+#define ALGINE_SHAREDPOSECACHE_H
+
+#include <algine/std/animation/BoneMatrices.h>
+#include <algine/std/animation/LocalPose.h>
+#include <algine/std/model/ModelPtr.h>
+#include <algine/types.h>
+
+#include <unordered_map>
+#include <vector>
+#include <deque>
+
+namespace algine {
+class Shape;
+
+/**
+ * Deduplicates animation evaluation of synchronized models: models with the
+ * same shape, animation and quantized time reference one evaluated palette.
+ * Models with custom bone transformations (see <code>Model::setBoneTransform</code>)
+ * are evaluated separately into their own bones.
+ * <br>Shared palettes are recycled by <code>beginFrame</code>, so all models
+ * must be animated again each frame. BoneSystemManager writes shared
+ * palettes only once per <code>writeBonesForAll</code>
+ */
+class SharedPoseCache {
+public:
+    void beginFrame();
+
+    /**
+     * Animates model with its animator's current animation and sets model bones
+     * @param model
+     * @param timeInSeconds
+     */
+    void animate(const ModelPtr &model, float timeInSeconds);
+
+    /// @param step - time quantization step in seconds, must be positive
+    void setTimeStep(float step);
+
+    float getTimeStep() const;
+
+    /// @return amount of animate calls since the last beginFrame
+    uint getRequestsCount() const;
+
+    /// @return amount of actual evaluations since the last beginFrame
+    uint getEvaluationsCount() const;
+
+private:
+    struct Key {
+        const Shape *shape;
+        Index animationIndex;
+        int64 tick;
+
+        bool operator==(const Key &other) const;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key &key) const;
+    };
+
+private:
+    std::unordered_map<Key, Index, KeyHash> m_keys;
+    std::deque<BoneMatrices> m_palettes;
+    uint m_usedPalettes = 0;
+    LocalPose m_pose;
+    std::vector<glm::mat4> m_globals;
+    BoneMatrices m_identityTransformations;
+    float m_timeStep = 1.0f / 60.0f;
+    uint m_requestsCount = 0;
+    uint m_evaluationsCount = 0;
+};
+}
+
+#endif //ALGINE_SHAREDPOSECACHE_H
@@ -0,0 +1,60 @@
+#ifndef ALGINE_SKELETON_H
+#define ALGINE_SKELETON_H
+
+#include <algine/std/animation/LocalPose.h>
+#include <algine/std/animation/BoneMask.h>
+#include <algine/types.h>
+
+#include <string>
+#include <vector>
+
+namespace algine {
+class Shape;
+class Node;
+
+/**
+ * Flattened node hierarchy of the shape: joints are stored in depth-first
+ * order, so every parent precedes its children and the whole hierarchy
+ * can be evaluated in one linear pass. Animation channels and bones are
+ * resolved to joint indices once, when the skeleton is built
+ */
+class Skeleton {
+public:
+    constexpr static Index None = -1;
+
+    struct Joint {
+        std::string name;
+        Index parent = None;
+        Index bone = None;
+        JointTransform defaultTransform;
+    };
+
+public:
+    void build(const Shape &shape);
+
+    Index getJointIndex(const std::string &name) const;
+    const Joint& getJoint(Index index) const;
+    const std::vector<Joint>& getJoints() const;
+    uint getJointsCount() const;
+
+    /**
+     * @return channel index of each joint in the specified animation,
+     * <code>Skeleton::None</code> for joints that are not animated
+     */
+    const std::vector<Index>& getChannels(Index animationIndex) const;
+
+    void getDefaultPose(LocalPose &out) const;
+
+    /// @return mask of the joints that have no children
+    BoneMask getLeafJoints() const;
+
+private:
+    void addJoint(const Node &node, Index parent, const Shape &shape);
+
+private:
+    std::vector<Joint> m_joints;
+    std::vector<std::vector<Index>> m_channels;
+};
+}
+
+#endif //ALGINE_SKELETON_H
@@ -0,0 +1,85 @@
+#ifndef ALGINE_SKINNINGPASS_H
+#define ALGINE_SKINNINGPASS_H
+
+#include <algine/std/animation/BoneSystemManager.h>
+#include <algine/std/model/InputLayoutShapeLocations.h>
+#include <algine/std/model/ModelPtr.h>
+
+#include <algine/core/shader/ShaderProgramPtr.h>
+#include <algine/core/buffers/ArrayBuffer.h>
+#include <algine/core/InputLayout.h>
+
+#include <unordered_map>
+
+namespace algine {
+class Shape;
+
+/**
+ * Optional pre-skinning stage: skins each added model once per frame
+ * into its own position / normal / tangent / bitangent buffers using transform
+ * feedback. Later passes (main, shadows) draw the model with <code>getInputLayout(model)</code>,
+ * which has no bone attributes, so their shaders can be compiled without
+ * <code>ALGINE_BONE_SYSTEM</code>. Texture coordinates are taken from the shape as is
+ */
+class SkinningPass {
+public:
+    ~SkinningPass();
+
+    /**
+     * Sets transform feedback varyings and relinks the program, so call it
+     * before loading locations. Program must be created from
+     * <code>Skinning.vert.glsl</code> with <code>ALGINE_BONE_SYSTEM</code>
+     * and registered in the bone system manager
+     */
+    void init();
+
+    /**
+     * Runs skinning for all added models. Bones must be already written
+     * to the bone system manager
+     */
+    void skin();
+
+    /**
+     * Creates skinned output buffers for the model
+     * @param model
+     * @param locations - locations of the passes that will use skinned data
+     */
+    void addModel(const ModelPtr &model, const InputLayoutShapeLocations &locations);
+    void removeModel(const ModelPtr &model);
+
+    void setShaderProgram(const ShaderProgramPtr &program);
+    void setBoneSystemManager(BoneSystemManager *manager);
+
+    const ShaderProgramPtr& getShaderProgram() const;
+    BoneSystemManager* getBoneSystemManager() const;
+
+    InputLayout* getInputLayout(const ModelPtr &model) const;
+    ArrayBuffer* getPositionsBuffer(const ModelPtr &model) const;
+    ArrayBuffer* getNormalsBuffer(const ModelPtr &model) const;
+    ArrayBuffer* getTangentsBuffer(const ModelPtr &model) const;
+    ArrayBuffer* getBitangentsBuffer(const ModelPtr &model) const;
+
+private:
+    struct Output {
+        ArrayBuffer *positions = nullptr;
+        ArrayBuffer *normals = nullptr;
+        ArrayBuffer *tangents = nullptr;
+        ArrayBuffer *bitangents = nullptr;
+        InputLayout *inputLayout = nullptr;
+        uint verticesCount = 0;
+    };
+
+private:
+    InputLayout* getSourceLayout(Shape *shape);
+
+private:
+    ShaderProgramPtr m_program;
+    BoneSystemManager *m_boneSystemManager = nullptr;
+    std::unordered_map<ModelPtr, Output> m_outputs;
+    std::unordered_map<Shape*, InputLayout*> m_sourceLayouts;
+    int m_inPosLocation = -1, m_inNormalLocation = -1;
+    int m_inTangentLocation = -1, m_inBitangentLocation = -1;
+};
+}
+
+#endif //ALGINE_SKINNINGPASS_H
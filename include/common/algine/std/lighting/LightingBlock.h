@@ -0,0 +1,92 @@
+#ifndef ALGINE_LIGHTINGBLOCK_H
+#define ALGINE_LIGHTINGBLOCK_H
+
+#include <algine/types.h>
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+
+namespace algine {
+/**
+ * C++ mirrors of the std140 <code>Lighting</code> uniform block
+ * declared in <code>modules/Lighting.glsl</code>. Both must be
+ * changed together; the offsets are checked at compile time
+ */
+namespace LightingBlock {
+struct Header {
+    uint pointLightsCount;
+    uint dirLightsCount;
+    float shadowOpacity;
+    float diskRadiusK;
+    float diskRadiusMin;
+    float padding[3];
+};
+
+struct DirLight {
+    glm::vec3 pos; // in world space
+    float kc; // constant term
+    glm::vec3 color;
+    float kl; // linear term
+    float kq; // quadratic term
+    float minBias;
+    float maxBias;
+    float padding;
+    glm::mat4 lightMatrix;
+};
+
+struct PointLight {
+    glm::vec3 pos; // in world space
+    float kc; // constant term
+    glm::vec3 color;
+    float kl; // linear term
+    float kq; // quadratic term
+    float far; // shadow matrix far plane
+    float bias;
+    float padding;
+};
+
+static_assert(offsetof(Header, pointLightsCount) == 0, "Header layout mismatch");
+static_assert(offsetof(Header, dirLightsCount) == 4, "Header layout mismatch");
+static_assert(offsetof(Header, shadowOpacity) == 8, "Header layout mismatch");
+static_assert(offsetof(Header, diskRadiusK) == 12, "Header layout mismatch");
+static_assert(offsetof(Header, diskRadiusMin) == 16, "Header layout mismatch");
+static_assert(sizeof(Header) == 32, "Header size must be a multiple of 16");
+
+static_assert(offsetof(DirLight, pos) == 0, "DirLight layout mismatch");
+static_assert(offsetof(DirLight, kc) == 12, "DirLight layout mismatch");
+static_assert(offsetof(DirLight, color) == 16, "DirLight layout mismatch");
+static_assert(offsetof(DirLight, kl) == 28, "DirLight layout mismatch");
+static_assert(offsetof(DirLight, kq) == 32, "DirLight layout mismatch");
+static_assert(offsetof(DirLight, minBias) == 36, "DirLight layout mismatch");
+static_assert(offsetof(DirLight, maxBias) == 40, "DirLight layout mismatch");
+static_assert(offsetof(DirLight, lightMatrix) == 48, "DirLight layout mismatch");
+static_assert(sizeof(DirLight) == 112, "DirLight array stride mismatch");
+
+static_assert(offsetof(PointLight, pos) == 0, "PointLight layout mismatch");
+static_assert(offsetof(PointLight, kc) == 12, "PointLight layout mismatch");
+static_assert(offsetof(PointLight, color) == 16, "PointLight layout mismatch");
+static_assert(offsetof(PointLight, kl) == 28, "PointLight layout mismatch");
+static_assert(offsetof(PointLight, kq) == 32, "PointLight layout mismatch");
+static_assert(offsetof(PointLight, far) == 36, "PointLight layout mismatch");
+static_assert(offsetof(PointLight, bias) == 40, "PointLight layout mismatch");
+static_assert(sizeof(PointLight) == 48, "PointLight array stride mismatch");
+
+// array lengths are shader defines, so array offsets depend on the limits
+
+constexpr uint getDirLightOffset(uint index) {
+    return sizeof(Header) + index * sizeof(DirLight);
+}
+
+constexpr uint getPointLightOffset(uint dirLightsLimit, uint index) {
+    return getDirLightOffset(dirLightsLimit) + index * sizeof(PointLight);
+}
+
+constexpr uint getSize(uint dirLightsLimit, uint pointLightsLimit) {
+    return getPointLightOffset(dirLightsLimit, pointLightsLimit);
+}
+}
+}
+
+#endif //ALGINE_LIGHTINGBLOCK_H
@@ -10,8 +10,6 @@
 #include <algine/std/lighting/DirLight.h>
 #include <algine/std/lighting/PointLight.h>
 
-#include <tulz/Array.h>
-
 namespace algine {
 class LightingManager {
 public:
@@ -27,10 +25,18 @@ public:
     void setLightShader(const ShaderProgramPtr &lightShader);
     void setPointLightShadowShader(const ShaderProgramPtr &shadowShader);
 
+    /**
+     * If enabled, write functions change the CPU copy of the buffer
+     * and <code>flush</code> must be called to upload them.
+     * Disabled by default; must be set before <code>init</code>
+     */
+    void setStagingEnabled(bool enabled);
+
     uint getLightsLimit(Light::Type lightType) const;
     uint getLightsMapInitialSlot(Light::Type lightType) const;
     const ShaderProgramPtr& getLightShader() const;
     const ShaderProgramPtr& getPointLightShadowShader() const;
+    bool isStagingEnabled() const;
     const BaseUniformBlock& getUniformBlock() const;
 
     void bindBuffer() const;
@@ -44,7 +50,14 @@ public:
     void pushShadowShaderFarPlane(const PointLight &light);
     void pushShadowShaderMatrices(const PointLight &light);
 
-    // write writes data to the buffer
+    // write writes data to the buffer or to its CPU copy if staging
+    // is enabled, buffer must be bound
+
+    /// uploads changed ranges if staging is enabled, buffer must be bound
+    void flush();
+
+    /// @return upload statistics of the last flush
+    const BufferMirror::Stats& getFlushStats() const;
 
     void writeDirLightsCount(uint count);
     void writePointLightsCount(uint count);
@@ -53,6 +66,10 @@ public:
     void writeShadowDiskRadiusK(float diskRadiusK);
     void writeShadowDiskRadiusMin(float diskRadiusMin);
 
+    /// writes all light fields with a single copy
+    void writeLight(const DirLight &light, uint index);
+    void writeLight(const PointLight &light, uint index);
+
     void writeKc(const Light &light, uint index);
     void writeKl(const Light &light, uint index);
     void writeKq(const Light &light, uint index);
@@ -67,20 +84,18 @@ public:
     void writeBias(const PointLight &light, uint index);
 
 private:
-    typedef tulz::Array<uint> LightOffsets;
+    uint getLightOffset(const Light &light, uint index) const;
 
 private:
     uint m_lightsLimit[Light::TypesCount];
     uint m_lightsInitialSlot[Light::TypesCount];
     ShaderProgramPtr m_lightShader;
     ShaderProgramPtr m_pointShadowShader;
+    bool m_stagingEnabled;
 
 private:
     BufferWriter m_bufferWriter;
     BaseUniformBlock m_uniformBlock;
-    tulz::Array<LightOffsets> m_offsets[Light::TypesCount];
-    uint m_lightsCountOffset[Light::TypesCount];
-    uint m_shadowOpacityOffset, m_shadowDiskRadiusKOffset, m_shadowDiskRadiusMinOffset;
     int m_shadowMapsLocations[Light::TypesCount];
     int m_shadowShaderPosLoc; // point light shadow shader locations; Loc means Location
     int m_shadowShaderFarPlaneLoc;
@@ -0,0 +1,106 @@
+#ifndef ALGINE_INSTANCESET_H
+#define ALGINE_INSTANCESET_H
+
+#include <algine/std/model/ShapePtr.h>
+#include <algine/core/buffers/ArrayBuffer.h>
+#include <algine/types.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+namespace algine {
+/**
+ * Instances of the shape: per-instance transformation and custom
+ * attributes, interleaved in one ArrayBuffer and added to the shape
+ * input layout with divisor 1. Each mesh is drawn once with
+ * <code>glDrawElementsInstanced</code>. If bounding sphere is set,
+ * <code>update</code> culls instances outside of the view frustum
+ * and uploads only the visible ones
+ */
+class InstanceSet {
+public:
+    explicit InstanceSet(const ShapePtr &shape);
+    ~InstanceSet();
+
+    /**
+     * Adds custom per-instance float attribute, must be called before
+     * <code>attach</code> and <code>addInstance</code>
+     * @param location
+     * @param count - components count, from 1 to 4
+     * @return attribute index
+     */
+    Index addAttribute(uint location, uint count);
+
+    /**
+     * Adds instance attributes to the shape input layout. Transformation
+     * is a mat4 attribute, it takes 4 locations starting from <code>transformLocation</code>
+     * @param inputLayoutIndex - index of the shape input layout
+     * @param transformLocation
+     */
+    void attach(Index inputLayoutIndex, uint transformLocation);
+
+    Index addInstance(const glm::mat4 &transform);
+    void setTransform(Index instance, const glm::mat4 &transform);
+    void setAttribute(Index instance, Index attribute, const glm::vec4 &value);
+    void reserve(uint count);
+    void clear();
+
+    /**
+     * Local space bounding sphere of the shape, is used for culling.
+     * If radius is 0, culling is disabled
+     */
+    void setBoundingSphere(const glm::vec3 &center, float radius);
+
+    /// uploads all instances
+    void update();
+
+    /**
+     * Uploads instances which intersect the view frustum
+     * @param viewProjection - projection * view matrix
+     */
+    void update(const glm::mat4 &viewProjection);
+
+    /**
+     * Binds input layout and draws all meshes. If meshes need different
+     * uniforms (e.g. materials), use <code>drawMesh</code> instead
+     */
+    void draw() const;
+
+    /// draws visible instances of the mesh, input layout must be bound
+    void drawMesh(Index mesh) const;
+
+    const ShapePtr& getShape() const;
+    const glm::mat4& getTransform(Index instance) const;
+    uint getInstancesCount() const;
+    uint getVisibleCount() const;
+    ArrayBuffer* getBuffer() const;
+
+private:
+    struct Attribute {
+        uint location;
+        uint count;
+        uint offset; // in floats
+    };
+
+private:
+    float* instance(Index index);
+    void upload(const std::vector<float> &data, uint instancesCount);
+
+private:
+    ShapePtr m_shape;
+    Index m_inputLayout = 0;
+    ArrayBuffer *m_buffer;
+    std::vector<Attribute> m_attributes;
+    std::vector<float> m_data;
+    std::vector<float> m_visible;
+    uint m_stride = 16; // in floats
+    uint m_visibleCount = 0;
+    glm::vec3 m_boundingCenter;
+    float m_boundingRadius = 0.0f;
+};
+}
+
+#endif //ALGINE_INSTANCESET_H
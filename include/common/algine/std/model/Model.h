@@ -3,6 +3,8 @@
 
 #include <algine/std/animation/Animator.h>
 #include <algine/std/animation/BoneMatrices.h>
+#include <algine/std/animation/BakedAnimation.h>
+#include <algine/std/animation/PosePool.h>
 #include <algine/std/Translatable.h>
 #include <algine/std/Scalable.h>
 #include <algine/std/Rotatable.h>
@@ -14,7 +16,6 @@
 namespace algine {
 class Model: public Object, public Rotatable, public Translatable, public Scalable {
     friend class Animator;
-    friend class AnimationBlender;
 
 public:
     explicit Model(const ShapePtr &shape, Rotator::Type rotatorType);
@@ -33,21 +34,66 @@ public:
     bool isAnimationActivated(uint index) const;
     bool isBonesPresent() const;
 
+    /// @return true if bone transformations were set and not reset since then
+    bool isBoneTransformationsCustom() const;
+
+    /// changes every time bones or bone transformations are changed
+    uint getBonesVersion() const;
+    uint getBoneTransformationsVersion() const;
+
     void setBoneTransform(const std::string &boneName, const BoneMatrix &transformation);
     void setBoneTransform(Index index, const BoneMatrix &transformation);
 
     void setShape(const ShapePtr &shape);
+
+    /// always marks bones as changed, even if the pointer is the same
     void setBones(const BoneMatrices *bones);
     void setBonesFromAnimation(Index animationIndex);
     void setBonesFromAnimation(const std::string &animationName);
     void setBoneTransformations(const BoneMatrices &transformations);
+    void resetBoneTransformations();
+
+    /**
+     * Marks bones as changed, must be called after modifying
+     * bones which were set via <code>setBones</code>
+     */
+    void invalidateBones();
+
+    /**
+     * Sets morph target weight. Weights are overwritten by the
+     * animator if the current animation has morph channels
+     */
+    void setMorphWeight(Index index, float weight);
+    void setMorphWeight(const std::string &targetName, float weight);
+
+    /**
+     * Sets pool which stores bones of the activated animations.
+     * Bones of the already activated animations will be moved to the new pool
+     */
+    void setPosePool(const PosePoolPtr &pool);
+
+    /**
+     * Makes model play baked animation with the specified phase offset (in seconds).
+     * Bones will be interpolated from the baked palette table by <code>updateBakedBones</code>,
+     * or on the GPU via <code>BakedAnimation::setUniforms</code> with <code>getBakedPose</code>
+     */
+    void setBakedAnimation(const BakedAnimation *animation, float phaseOffset = 0.0f);
+    void updateBakedBones(float timeInSeconds);
 
     const ShapePtr& getShape() const;
     Animator* getAnimator() const;
     glm::mat4& transformation();
+
+    /// @return nullptr until bones are set or an animation is sampled
     const BoneMatrices* getBones() const;
+
     const BoneMatrix& getBone(Index index) const;
     const BoneMatrices& getBoneTransformations() const;
+    const PosePoolPtr& getPosePool() const;
+    const BakedAnimation* getBakedAnimation() const;
+    BakedAnimation::Pose getBakedPose(float timeInSeconds) const;
+    float getBakedPhaseOffset() const;
+    const std::vector<float>& getMorphWeights() const;
 
 public:
     static ModelPtr getByName(const std::string &name);
@@ -65,8 +111,25 @@ protected:
     const BoneMatrices *m_bones = nullptr;
 
 protected:
-    std::vector<BoneMatrices> m_animBones;
+    /// activates animation if it is not activated yet
+    BoneMatrices& animationBones(Index index);
+    void releaseAnimations();
+
+protected:
+    PosePoolPtr m_posePool = PosePool::getDefault();
+    std::vector<PosePool::Slot> m_animSlots;
     BoneMatrices m_boneTransformations;
+    bool m_customBoneTransformations = false;
+    uint m_bonesVersion = 0;
+    uint m_boneTransformationsVersion = 0;
+
+protected:
+    std::vector<float> m_morphWeights;
+
+protected:
+    const BakedAnimation *m_bakedAnimation = nullptr;
+    float m_bakedPhaseOffset = 0.0f;
+    BoneMatrices m_bakedBones;
 };
 }
 
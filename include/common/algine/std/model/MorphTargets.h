@@ -0,0 +1,94 @@
+#ifndef ALGINE_MORPHTARGETS_H
+#define ALGINE_MORPHTARGETS_H
+
+#include <algine/core/buffers/ArrayBuffer.h>
+#include <algine/core/texture/TextureBuffer.h>
+#include <algine/core/shader/ShaderProgram.h>
+#include <algine/types.h>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+namespace algine {
+/**
+ * Sparse morph targets (blend shapes) of the shape. Each target stores
+ * only changed vertices, sorted by vertex index, as one RGBA32UI texel:
+ * vertex index and 16-bit normalized position / normal deltas.
+ * Deltas of all targets are packed into one texture buffer and evaluated
+ * in the vertex shader by <code>modules/MorphTargets.glsl</code>
+ */
+class MorphTargets {
+public:
+    constexpr static Index TargetNotFound = -1;
+
+    struct Target {
+        std::string name;
+        std::string meshName;
+        uint start = 0; // first delta
+        uint count = 0; // deltas count
+        float positionScale = 0.0f;
+    };
+
+public:
+    ~MorphTargets();
+
+    /**
+     * Quantizes and adds target. Targets of one mesh must be added one after another
+     * @param name
+     * @param meshName
+     * @param vertices - changed vertices, ascending
+     * @param positionDeltas
+     * @param normalDeltas - can be empty
+     */
+    void addTarget(const std::string &name, const std::string &meshName, const std::vector<uint> &vertices,
+                   const std::vector<glm::vec3> &positionDeltas, const std::vector<glm::vec3> &normalDeltas);
+
+    void createBuffer();
+
+    /**
+     * Selects up to <code>maxActiveTargets</code> targets with the biggest
+     * absolute weights, binds deltas to the specified slot and sets uniforms.
+     * Program must be bound
+     */
+    void setUniforms(ShaderProgram *program, const std::vector<float> &weights, uint textureSlot) const;
+
+    /// must match <code>MAX_MORPH_TARGETS</code>, 8 by default
+    void setMaxActiveTargets(uint count);
+
+    Index getTargetIndex(const std::string &name) const;
+    Index getTargetIndex(const std::string &meshName, Index meshTargetIndex) const;
+    const Target& getTarget(Index index) const;
+    uint getTargetsCount() const;
+    uint getMaxActiveTargets() const;
+    bool empty() const;
+
+    /// @return size of the quantized deltas in bytes
+    uint getSizeInBytes() const;
+
+    TextureBuffer* getTexture() const;
+
+private:
+    struct MeshTargets {
+        Index first;
+        uint count;
+    };
+
+private:
+    std::vector<Target> m_targets;
+    std::vector<glm::uvec4> m_deltas;
+    std::unordered_map<std::string, MeshTargets> m_meshTargets;
+    ArrayBuffer *m_buffer = nullptr;
+    TextureBuffer *m_texture = nullptr;
+    uint m_maxActiveTargets = 8;
+
+private:
+    mutable std::vector<Index> m_activeTargets;
+    mutable std::vector<glm::vec4> m_activeTargetsData;
+};
+}
+
+#endif //ALGINE_MORPHTARGETS_H
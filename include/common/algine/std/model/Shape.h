@@ -3,10 +3,12 @@
 
 #include <algine/std/model/InputLayoutShapeLocations.h>
 #include <algine/std/model/Mesh.h>
+#include <algine/std/model/MorphTargets.h>
 #include <algine/std/model/ShapePtr.h>
 
 #include <algine/std/animation/Animation.h>
 #include <algine/std/animation/BonesStorage.h>
+#include <algine/std/animation/Skeleton.h>
 #include <algine/std/Node.h>
 
 #include <algine/core/InputLayout.h>
@@ -18,7 +20,6 @@ class Shape: public Object {
     friend class ShapeManager;
     friend class Model;
     friend class Animator;
-    friend class AnimationBlender;
 
 public:
     constexpr static Index AnimationNotFound = -1;
@@ -36,8 +37,16 @@ public:
     void addMesh(const Mesh &mesh);
     void addAnimation(const Animation &animation);
 
+    /**
+     * Rebuilds skeleton from the root node, bones and animations.
+     * Called automatically by ShapeManager, <code>setAnimations</code>
+     * and <code>addAnimation</code>
+     */
+    void updateSkeleton();
+
     bool isBonesPresent() const;
     bool isAnimationsPresent() const;
+    bool isMorphTargetsPresent() const;
 
     const std::vector<Mesh>& getMeshes() const;
     const std::vector<Animation>& getAnimations() const;
@@ -45,6 +54,8 @@ public:
     const glm::mat4& getGlobalInverseTransform() const;
     const BonesStorage& getBones() const;
     const Node& getRootNode() const;
+    const Skeleton& getSkeleton() const;
+    const MorphTargets& getMorphTargets() const;
     uint getBonesPerVertex() const;
 
     const Animation& getAnimation(Index index) const;
@@ -78,6 +89,8 @@ protected:
     glm::mat4 m_globalInverseTransform;
     BonesStorage m_bones;
     Node m_rootNode;
+    Skeleton m_skeleton;
+    MorphTargets m_morphTargets;
     uint m_bonesPerVertex;
 
 protected:
@@ -4,6 +4,7 @@
 #include <algine/std/model/InputLayoutShapeLocationsManager.h>
 #include <algine/std/model/ShapePtr.h>
 #include <algine/std/model/Shape.h>
+#include <algine/std/animation/AnimationCompressor.h>
 #include <algine/std/AMTLManager.h>
 
 #include <algine/core/ManagerBase.h>
@@ -20,7 +21,8 @@ public:
         CalcTangentSpace,
         JoinIdenticalVertices,
         InverseNormals,
-        DisableBones
+        DisableBones,
+        CompressAnimations
     };
 
     enum class AMTLDumpMode {
@@ -44,6 +46,7 @@ public:
     void setAMTL(const AMTLManager &amtlManager);
     void setBonesPerVertex(uint bonesPerVertex);
     void setClassName(const std::string &name);
+    void setAnimationCompressor(const AnimationCompressor &compressor);
 
     const std::vector<Param>& getParams() const;
     const std::vector<InputLayoutShapeLocationsManager>& getInputLayoutLocations() const;
@@ -53,6 +56,7 @@ public:
     const AMTLManager& getAMTL() const;
     uint getBonesPerVertex() const;
     const std::string& getClassName() const;
+    const AnimationCompressor& getAnimationCompressor() const;
 
     const std::vector<float>& getVertices() const;
     void setVertices(const std::vector<float> &vertices);
@@ -94,6 +98,7 @@ public:
 
 private:
     void loadBones(const aiMesh *aimesh);
+    void loadMorphTargets(const aiMesh *aimesh, uint firstVertex);
     void processNode(const aiNode *node, const aiScene *scene);
     void processMesh(const aiMesh *aimesh, const aiScene *scene);
     void genBuffers();
@@ -106,6 +111,9 @@ private:
     std::vector<float> m_vertices, m_normals, m_texCoords, m_tangents, m_bitangents, m_boneWeights;
     std::vector<uint> m_indices, m_boneIds;
 
+    // by scene mesh index; meshes can be referenced by several nodes
+    std::vector<bool> m_morphMeshesLoaded;
+
 private:
     std::vector<Param> m_params;
     std::vector<InputLayoutShapeLocationsManager> m_locations;
@@ -113,6 +121,7 @@ private:
     std::string m_modelPath, m_amtlPath;
 
     AMTLManager m_amtlManager;
+    AnimationCompressor m_animationCompressor;
     uint m_bonesPerVertex;
 
 private:
@@ -0,0 +1,62 @@
+/**
+ * Batch Renderer
+ * It is module, not shader
+ * Add it in your vertex shader via
+ * #alp include "modules/BatchRenderer.glsl"
+ * before any other declarations
+ */
+
+#ifdef ALGINE_BATCH_RENDERER
+#ifdef ALGINE_BATCH_DRAW_PARAMETERS
+#extension GL_ARB_shader_draw_parameters : require
+#endif
+
+/**
+ * Per-draw data, 5 texels per draw:
+ * transformation matrix columns, (material index, 0, 0, 0)
+ */
+uniform samplerBuffer batchDraws;
+
+/**
+ * Materials, one texel per material:
+ * (ambient strength, diffuse strength, specular strength, shininess)
+ */
+uniform samplerBuffer batchMaterials;
+
+/**
+ * Index of the first draw of the current multi-draw call,
+ * or index of the current draw if draws are issued one by one
+ */
+uniform int batchDrawOffset;
+
+int getBatchDrawId() {
+#ifdef ALGINE_BATCH_DRAW_PARAMETERS
+    return batchDrawOffset + gl_DrawIDARB;
+#else
+    return batchDrawOffset;
+#endif
+}
+
+mat4 getBatchTransform(int drawId) {
+    int texel = drawId * 5;
+
+    return mat4(
+        texelFetch(batchDraws, texel),
+        texelFetch(batchDraws, texel + 1),
+        texelFetch(batchDraws, texel + 2),
+        texelFetch(batchDraws, texel + 3)
+    );
+}
+
+/**
+ * Fragment shaders have no draw id, so the material index
+ * should be passed as a flat varying
+ */
+int getBatchMaterialIndex(int drawId) {
+    return int(texelFetch(batchDraws, drawId * 5 + 4).x);
+}
+
+vec4 getBatchMaterial(int materialIndex) {
+    return texelFetch(batchMaterials, materialIndex);
+}
+#endif
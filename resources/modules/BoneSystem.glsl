@@ -5,10 +5,43 @@
  * #alp include "modules/BoneSystem.glsl"
  */
 
+/**
+ * ALGINE_DUAL_QUATERNION_SKINNING: each bone is a unit dual quaternion,
+ * stored as 2 vec4 (real part, dual part). With ALGINE_DUAL_QUATERNION_SCALE
+ * bones have uniform scale as well: packed 4 per vec4 in boneScales in the
+ * uniform block mode, or stored as the 3rd texel in the palette mode
+ */
+#ifdef ALGINE_DUAL_QUATERNION_SKINNING
+    #ifdef ALGINE_DUAL_QUATERNION_SCALE
+        #define BONE_TEXELS 3
+    #else
+        #define BONE_TEXELS 2
+    #endif
+#else
+    #define BONE_TEXELS 4
+#endif
+
+#ifdef ALGINE_BONE_SYSTEM_PALETTE
+/**
+ * Bones of all models are packed into one texture buffer,
+ * each bone takes BONE_TEXELS texels, model bones start at boneBaseOffset
+ */
+uniform samplerBuffer bonePalette;
+uniform int boneBaseOffset;
+uniform int boneAttribsPerVertex;
+#else
 uniform BoneSystem {
+    #ifdef ALGINE_DUAL_QUATERNION_SKINNING
+    vec4 bones[MAX_BONES * 2];
+    #ifdef ALGINE_DUAL_QUATERNION_SCALE
+    vec4 boneScales[(MAX_BONES + 3) / 4];
+    #endif
+    #else
     mat4 bones[MAX_BONES];
+    #endif
     int boneAttribsPerVertex;
 };
+#endif
 
 in vec4 inBoneWeights[MAX_BONE_ATTRIBS_PER_VERTEX];
 in ivec4 inBoneIds[MAX_BONE_ATTRIBS_PER_VERTEX];
@@ -16,15 +49,124 @@ in ivec4 inBoneIds[MAX_BONE_ATTRIBS_PER_VERTEX];
 #define isBonesPresent() (boneAttribsPerVertex > 0)
 #define getBonesCount() boneAttribsPerVertex
 
+#ifdef ALGINE_BAKED_ANIMATION
+/**
+ * Baked palette table: each row is a frame, each bone takes 4 texels
+ * bakedPose: frame, next frame, interpolation factor
+ */
+uniform sampler2D bakedBones;
+uniform vec3 bakedPose;
+
+mat4 getBakedBone(int frame, int bone) {
+    int x = bone * 4;
+
+    return mat4(
+        texelFetch(bakedBones, ivec2(x, frame), 0),
+        texelFetch(bakedBones, ivec2(x + 1, frame), 0),
+        texelFetch(bakedBones, ivec2(x + 2, frame), 0),
+        texelFetch(bakedBones, ivec2(x + 3, frame), 0)
+    );
+}
+
+mat4 getBone(int bone) {
+    mat4 frame = getBakedBone(int(bakedPose.x), bone);
+    mat4 nextFrame = getBakedBone(int(bakedPose.y), bone);
+
+    return frame + (nextFrame - frame) * bakedPose.z;
+}
+#elif defined(ALGINE_DUAL_QUATERNION_SKINNING)
+#ifdef ALGINE_BONE_SYSTEM_PALETTE
+#define getBoneReal(bone) texelFetch(bonePalette, (boneBaseOffset + (bone)) * BONE_TEXELS)
+#define getBoneDual(bone) texelFetch(bonePalette, (boneBaseOffset + (bone)) * BONE_TEXELS + 1)
+#define getBoneScale(bone) texelFetch(bonePalette, (boneBaseOffset + (bone)) * BONE_TEXELS + 2).x
+#else
+#define getBoneReal(bone) bones[(bone) * 2]
+#define getBoneDual(bone) bones[(bone) * 2 + 1]
+#define getBoneScale(bone) boneScales[(bone) / 4][(bone) % 4]
+#endif
+#elif defined(ALGINE_BONE_SYSTEM_PALETTE)
+mat4 getBone(int bone) {
+    int index = (boneBaseOffset + bone) * 4;
+
+    return mat4(
+        texelFetch(bonePalette, index),
+        texelFetch(bonePalette, index + 1),
+        texelFetch(bonePalette, index + 2),
+        texelFetch(bonePalette, index + 3)
+    );
+}
+#else
+#define getBone(bone) bones[bone]
+#endif
+
+#if defined(ALGINE_DUAL_QUATERNION_SKINNING) && !defined(ALGINE_BAKED_ANIMATION)
+vec4 g_realSum;
+vec4 g_dualSum;
+float g_scaleSum;
+
+void addBone(int bone, float weight) {
+    vec4 real = getBoneReal(bone);
+
+    // q and -q are the same rotation, blend along the shortest path
+    if (dot(real, g_realSum) < 0.0)
+        weight = -weight;
+
+    g_realSum += real * weight;
+    g_dualSum += getBoneDual(bone) * weight;
+
+    #ifdef ALGINE_DUAL_QUATERNION_SCALE
+    g_scaleSum += getBoneScale(bone) * abs(weight);
+    #endif
+}
+
+mat4 getBoneTransformMatrix() {
+    g_realSum = vec4(0.0);
+    g_dualSum = vec4(0.0);
+    g_scaleSum = 0.0;
+
+    for (int i = 0; i < boneAttribsPerVertex; i++) {
+        addBone(inBoneIds[i].x, inBoneWeights[i].x);
+        addBone(inBoneIds[i].y, inBoneWeights[i].y);
+        addBone(inBoneIds[i].z, inBoneWeights[i].z);
+        addBone(inBoneIds[i].w, inBoneWeights[i].w);
+    }
+
+    float len = length(g_realSum);
+    vec4 r = g_realSum / len;
+    vec4 d = g_dualSum / len;
+
+    vec3 translation = 2.0 * (r.w * d.xyz - d.w * r.xyz + cross(r.xyz, d.xyz));
+
+    float xx = r.x * r.x, yy = r.y * r.y, zz = r.z * r.z;
+    float xy = r.x * r.y, xz = r.x * r.z, yz = r.y * r.z;
+    float wx = r.w * r.x, wy = r.w * r.y, wz = r.w * r.z;
+
+    mat4 transform = mat4(
+        1.0 - 2.0 * (yy + zz), 2.0 * (xy + wz), 2.0 * (xz - wy), 0.0,
+        2.0 * (xy - wz), 1.0 - 2.0 * (xx + zz), 2.0 * (yz + wx), 0.0,
+        2.0 * (xz + wy), 2.0 * (yz - wx), 1.0 - 2.0 * (xx + yy), 0.0,
+        translation, 1.0
+    );
+
+    #ifdef ALGINE_DUAL_QUATERNION_SCALE
+    transform[0].xyz *= g_scaleSum;
+    transform[1].xyz *= g_scaleSum;
+    transform[2].xyz *= g_scaleSum;
+    #endif
+
+    return transform;
+}
+#else
 mat4 getBoneTransformMatrix() {
     mat4 finalTransform = mat4(0.0);
 
     for (int i = 0; i < boneAttribsPerVertex; i++) {
-        finalTransform += bones[inBoneIds[i].x] * inBoneWeights[i].x;
-        finalTransform += bones[inBoneIds[i].y] * inBoneWeights[i].y;
-        finalTransform += bones[inBoneIds[i].z] * inBoneWeights[i].z;
-        finalTransform += bones[inBoneIds[i].w] * inBoneWeights[i].w;
+        finalTransform += getBone(inBoneIds[i].x) * inBoneWeights[i].x;
+        finalTransform += getBone(inBoneIds[i].y) * inBoneWeights[i].y;
+        finalTransform += getBone(inBoneIds[i].z) * inBoneWeights[i].z;
+        finalTransform += getBone(inBoneIds[i].w) * inBoneWeights[i].w;
     }
 
     return finalTransform;
-}
\ No newline at end of file
+}
+#endif
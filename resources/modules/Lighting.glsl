@@ -13,36 +13,39 @@
 #ifndef ALGINE_MODULE_LIGHTING_GLSL
 #define ALGINE_MODULE_LIGHTING_GLSL
 
+// std140, C++ mirror: algine/std/lighting/LightingBlock.h
+// vec3 members are followed by scalars to fill their 16 byte slots
+
 struct DirLight {
+	vec3 pos; // in world space
 	float kc; // constant term
+	vec3 color;
 	float kl; // linear term
 	float kq; // quadratic term
 	float minBias, maxBias;
-	vec3 pos; // in world space
-	vec3 color;
 	mat4 lightMatrix;
 };
 
 struct PointLight {
+	vec3 pos; // in world space
 	float kc; // constant term
+	vec3 color;
 	float kl; // linear term
 	float kq; // quadratic term
 	float far; // shadow matrix far plane
 	float bias;
-	vec3 pos; // in world space
-	vec3 color;
 };
 
-layout(packed) uniform Lighting {
-	DirLight dirLights[MAX_DIR_LIGHTS_COUNT];
-	PointLight pointLights[MAX_POINT_LIGHTS_COUNT];
-
+layout(std140) uniform Lighting {
 	uint pointLightsCount;
 	uint dirLightsCount;
 
 	float shadowOpacity;
 	float diskRadius_k;
 	float diskRadius_min;
+
+	DirLight dirLights[MAX_DIR_LIGHTS_COUNT];
+	PointLight pointLights[MAX_POINT_LIGHTS_COUNT];
 };
 
 uniform samplerCube pointLightShadowMaps[MAX_POINT_LIGHTS_COUNT];
@@ -0,0 +1,67 @@
+/**
+ * Morph Targets
+ * It is module, not shader
+ * Add it in your shader via
+ * #alp include "modules/MorphTargets.glsl"
+ */
+
+#ifdef ALGINE_MORPH_TARGETS
+/**
+ * Sparse deltas of all shape targets, one texel per changed vertex:
+ * (vertex, position.xy, position.z & normal.x, normal.yz),
+ * components are packed as snorm16 pairs. Deltas of each target
+ * are sorted by vertex index
+ */
+uniform usamplerBuffer morphDeltas;
+
+/**
+ * Active targets: (first texel, texels count, position scale, weight)
+ */
+uniform vec4 morphTargets[MAX_MORPH_TARGETS];
+uniform int morphTargetsCount;
+
+float unpackLow(uint bits) {
+    return float(int(bits << 16u) >> 16) / 32767.0;
+}
+
+float unpackHigh(uint bits) {
+    return float(int(bits) >> 16) / 32767.0;
+}
+
+void applyMorphTargets(inout vec4 position, inout vec3 normal) {
+    uint vertex = uint(gl_VertexID);
+
+    for (int i = 0; i < morphTargetsCount; i++) {
+        vec4 target = morphTargets[i];
+
+        int start = int(target.x);
+        int end = start + int(target.y);
+
+        // binary search of the vertex in the target range
+        while (start < end) {
+            int middle = (start + end) / 2;
+
+            if (texelFetch(morphDeltas, middle).x < vertex) {
+                start = middle + 1;
+            } else {
+                end = middle;
+            }
+        }
+
+        uvec4 delta = texelFetch(morphDeltas, start);
+
+        if (start < int(target.x + target.y) && delta.x == vertex) {
+            float positionWeight = target.z * target.w;
+            float normalWeight = 2.0 * target.w;
+
+            position.xyz += vec3(unpackLow(delta.y), unpackHigh(delta.y), unpackLow(delta.z)) * positionWeight;
+            normal += vec3(unpackHigh(delta.z), unpackLow(delta.w), unpackHigh(delta.w)) * normalWeight;
+        }
+    }
+}
+
+void applyMorphTargets(inout vec4 position) {
+    vec3 normal = vec3(0.0);
+    applyMorphTargets(position, normal);
+}
+#endif
@@ -1,4 +1,5 @@
 #pragma algine include "modules/BoneSystem.glsl"
+#pragma algine include "modules/MorphTargets.glsl"
 
 in vec4 a_Position;
 
@@ -9,6 +10,10 @@ uniform mat4 transformationMatrix;
 void main() {
 	vec4 position = a_Position;
 
+	#ifdef ALGINE_MORPH_TARGETS
+    applyMorphTargets(position);
+    #endif
+
 	#ifdef ALGINE_BONE_SYSTEM
     if (isBonesPresent()) {
         position = getBoneTransformMatrix() * position;
@@ -0,0 +1,45 @@
+/**
+ * Pre-skinning pass: skins vertices once per frame,
+ * results are captured with transform feedback
+ */
+
+#pragma algine include "modules/BoneSystem.glsl"
+#pragma algine include "modules/MorphTargets.glsl"
+
+in vec4 a_Position;
+in vec3 a_Normal;
+in vec3 a_Tangent;
+in vec3 a_Bitangent;
+
+out vec3 skinnedPosition;
+out vec3 skinnedNormal;
+out vec3 skinnedTangent;
+out vec3 skinnedBitangent;
+
+void main() {
+    vec4 position = a_Position;
+    vec3 normal = a_Normal;
+    vec3 tangent = a_Tangent;
+    vec3 bitangent = a_Bitangent;
+
+    #ifdef ALGINE_MORPH_TARGETS
+    applyMorphTargets(position, normal);
+    #endif
+
+    #ifdef ALGINE_BONE_SYSTEM
+    if (isBonesPresent()) {
+        mat4 boneTransform = getBoneTransformMatrix();
+        position = boneTransform * position;
+        normal = mat3(boneTransform) * normal;
+        tangent = mat3(boneTransform) * tangent;
+        bitangent = mat3(boneTransform) * bitangent;
+    }
+    #endif
+
+    skinnedPosition = position.xyz;
+    skinnedNormal = normalize(normal);
+
+    // not normalized: they are zero if the shape has no tangents
+    skinnedTangent = tangent;
+    skinnedBitangent = bitangent;
+}
@@ -8,6 +8,7 @@
 #version 330
 
 #alp include "modules/BoneSystem.glsl"
+#alp include "modules/MorphTargets.glsl"
 #alp include "modules/NormalMapping.vert.glsl"
 
 uniform mat4 MVPMatrix, modelMatrix, viewMatrix, MVMatrix;
@@ -27,6 +28,10 @@ void main() {
     vec4 position = inPos;
     vec3 normal = inNormal;
 
+    #ifdef ALGINE_MORPH_TARGETS
+    applyMorphTargets(position, normal);
+    #endif
+
     #ifdef ALGINE_BONE_SYSTEM
     if (isBonesPresent()) {
         mat4 finalTransform = getBoneTransformMatrix();
@@ -0,0 +1,197 @@
+#include <algine/core/AsyncReadback.h>
+
+#include <algine/gl.h>
+
+#include <stdexcept>
+#include <cstring>
+#include <string>
+
+using namespace std;
+using namespace tulz;
+
+namespace algine {
+constexpr uint64 waitTimeout = 1000000; // 1 ms
+
+inline uint getComponentsCount(uint format) {
+    switch (format) {
+        case GL_RG: return 2;
+        case GL_RGB: return 3;
+        case GL_RGBA: return 4;
+        default: return 1;
+    }
+}
+
+inline uint getDataTypeSize(DataType dataType) {
+    switch (dataType) {
+        case DataType::Byte:
+        case DataType::UnsignedByte:
+            return 1;
+        case DataType::Short:
+        case DataType::UnsignedShort:
+        case DataType::HalfFloat:
+            return 2;
+        case DataType::Double:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+AsyncReadback::AsyncReadback() = default;
+
+AsyncReadback::~AsyncReadback() {
+    for (auto &[handle, request] : m_requests) {
+        glDeleteSync(static_cast<GLsync>(request.fence));
+        glDeleteBuffers(1, &request.staging.id);
+    }
+
+    for (auto &staging : m_free) {
+        glDeleteBuffers(1, &staging.id);
+    }
+}
+
+AsyncReadback::Handle AsyncReadback::read(const Buffer *buffer, uint offset, uint size) {
+    auto staging = acquire(size);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer->getId());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, staging.id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, 0, size);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    return push(staging, size);
+}
+
+AsyncReadback::Handle AsyncReadback::readPixels(uint attachment, uint x, uint y, uint width, uint height,
+                                                uint format, DataType dataType)
+{
+    uint size = width * height * getComponentsCount(format) * getDataTypeSize(dataType);
+    auto staging = acquire(size);
+
+    int readBuffer = GL_NONE;
+
+    if (format != GL_DEPTH_COMPONENT) {
+        glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+        glReadBuffer(attachment);
+    }
+
+    // rows are tightly packed, as the staging size assumes;
+    // the default alignment is 4 and would overflow the staging buffer
+    int packAlignment;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    // with bound pack buffer the last argument is an offset
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, staging.id);
+    glReadPixels(x, y, width, height, format, static_cast<GLenum>(dataType), nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+
+    if (format != GL_DEPTH_COMPONENT)
+        glReadBuffer(static_cast<GLenum>(readBuffer));
+
+    return push(staging, size);
+}
+
+bool AsyncReadback::isReady(Handle handle) {
+    auto &request = m_requests.at(handle);
+    auto status = glClientWaitSync(static_cast<GLsync>(request.fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+    return status != GL_TIMEOUT_EXPIRED && status != GL_WAIT_FAILED;
+}
+
+Array<byte> AsyncReadback::take(Handle handle) {
+    auto it = m_requests.find(handle);
+
+    if (it == m_requests.end())
+        throw invalid_argument("AsyncReadback: unknown handle " + to_string(handle));
+
+    auto &request = it->second;
+    auto fence = static_cast<GLsync>(request.fence);
+
+    if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
+        m_waitsCount++;
+
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, waitTimeout) == GL_TIMEOUT_EXPIRED);
+    }
+
+    Array<byte> data(request.size);
+
+    if (request.size > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, request.staging.id);
+
+        auto mapped = glMapBufferRange(GL_COPY_READ_BUFFER, 0, request.size, GL_MAP_READ_BIT);
+
+        if (mapped != nullptr) {
+            memcpy(data.array(), mapped, request.size);
+        }
+
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+
+    release(request);
+    m_requests.erase(it);
+
+    return data;
+}
+
+void AsyncReadback::cancel(Handle handle) {
+    if (auto it = m_requests.find(handle); it != m_requests.end()) {
+        release(it->second);
+        m_requests.erase(it);
+    }
+}
+
+uint AsyncReadback::getPendingCount() const {
+    return m_requests.size();
+}
+
+uint AsyncReadback::getWaitsCount() const {
+    return m_waitsCount;
+}
+
+AsyncReadback::Staging AsyncReadback::acquire(uint size) {
+    // smallest free staging buffer which fits
+    auto best = m_free.end();
+
+    for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+        if (it->size >= size && (best == m_free.end() || it->size < best->size)) {
+            best = it;
+        }
+    }
+
+    if (best != m_free.end()) {
+        Staging staging = *best;
+        m_free.erase(best);
+        return staging;
+    }
+
+    Staging staging {};
+    staging.size = size;
+
+    glGenBuffers(1, &staging.id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, staging.id);
+    glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_READ);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    return staging;
+}
+
+void AsyncReadback::release(const Request &request) {
+    glDeleteSync(static_cast<GLsync>(request.fence));
+    m_free.emplace_back(request.staging);
+}
+
+AsyncReadback::Handle AsyncReadback::push(const Staging &staging, uint size) {
+    Request request {};
+    request.staging = staging;
+    request.size = size;
+    request.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_requests[++m_lastHandle] = request;
+
+    return m_lastHandle;
+}
+}
@@ -3,12 +3,15 @@
 #include <algine/core/Framebuffer.h>
 #include <algine/core/texture/Texture2D.h>
 #include <algine/core/texture/TextureCube.h>
+#include <algine/core/texture/TextureBuffer.h>
 #include <algine/core/buffers/ArrayBuffer.h>
 #include <algine/core/buffers/IndexBuffer.h>
 #include <algine/core/buffers/UniformBuffer.h>
+#include <algine/core/buffers/IndirectBuffer.h>
 #include <algine/core/shader/ShaderProgram.h>
 #include <algine/core/InputLayout.h>
 #include <algine/core/TypeRegistry.h>
+#include <algine/core/StateCache.h>
 
 #include <algine/gl.h>
 
@@ -49,9 +52,11 @@ Framebuffer* Engine::m_defaultFramebuffer;
 Renderbuffer* Engine::m_defaultRenderbuffer;
 Texture2D* Engine::m_defaultTexture2D;
 TextureCube* Engine::m_defaultTextureCube;
+TextureBuffer* Engine::m_defaultTextureBuffer;
 ArrayBuffer* Engine::m_defaultArrayBuffer;
 IndexBuffer* Engine::m_defaultIndexBuffer;
 UniformBuffer* Engine::m_defaultUniformBuffer;
+IndirectBuffer* Engine::m_defaultIndirectBuffer;
 ShaderProgram* Engine::m_defaultShaderProgram;
 InputLayout* Engine::m_defaultInputLayout;
 
@@ -59,9 +64,11 @@ Framebuffer* Engine::m_boundFramebuffer;
 Renderbuffer* Engine::m_boundRenderbuffer;
 Texture2D* Engine::m_boundTexture2D;
 TextureCube* Engine::m_boundTextureCube;
+TextureBuffer* Engine::m_boundTextureBuffer;
 ArrayBuffer* Engine::m_boundArrayBuffer;
 IndexBuffer* Engine::m_boundIndexBuffer;
 UniformBuffer* Engine::m_boundUniformBuffer;
+IndirectBuffer* Engine::m_boundIndirectBuffer;
 ShaderProgram* Engine::m_boundShaderProgram;
 InputLayout* Engine::m_boundInputLayout;
 
@@ -78,6 +85,8 @@ void Engine::init() {
 
     m_startTime = Engine::time();
 
+    StateCache::invalidate();
+
     // We use malloc instead of new since we don't want the ctor to be
     // called because ctor generates new texture id. We don't need it.
     // In the case of increasing the number of operations performed by
@@ -85,10 +94,29 @@ void Engine::init() {
     m_defaultTexture2D = (Texture2D*) malloc(sizeof(Texture2D));
     m_defaultTexture2D->m_id = 0;
     m_defaultTexture2D->m_target = GL_TEXTURE_2D;
+    m_defaultTexture2D->m_immutable = false;
+    m_defaultTexture2D->m_mipLevels = 0;
+    m_defaultTexture2D->m_storageFormat = 0;
+    m_defaultTexture2D->m_storageWidth = 0;
+    m_defaultTexture2D->m_storageHeight = 0;
 
     m_defaultTextureCube = (TextureCube*) malloc(sizeof(TextureCube));
     m_defaultTextureCube->m_id = 0;
     m_defaultTextureCube->m_target = GL_TEXTURE_CUBE_MAP;
+    m_defaultTextureCube->m_immutable = false;
+    m_defaultTextureCube->m_mipLevels = 0;
+    m_defaultTextureCube->m_storageFormat = 0;
+    m_defaultTextureCube->m_storageWidth = 0;
+    m_defaultTextureCube->m_storageHeight = 0;
+
+    m_defaultTextureBuffer = (TextureBuffer*) malloc(sizeof(TextureBuffer));
+    m_defaultTextureBuffer->m_id = 0;
+    m_defaultTextureBuffer->m_target = TextureBuffer::Target;
+    m_defaultTextureBuffer->m_immutable = false;
+    m_defaultTextureBuffer->m_mipLevels = 0;
+    m_defaultTextureBuffer->m_storageFormat = 0;
+    m_defaultTextureBuffer->m_storageWidth = 0;
+    m_defaultTextureBuffer->m_storageHeight = 0;
 
     m_defaultFramebuffer = (Framebuffer*) malloc(sizeof(Framebuffer));
     m_defaultFramebuffer->m_id = 0;
@@ -99,17 +127,35 @@ void Engine::init() {
     m_defaultArrayBuffer = (ArrayBuffer*) malloc(sizeof(ArrayBuffer));
     m_defaultArrayBuffer->m_id = 0;
     m_defaultArrayBuffer->m_target = GL_ARRAY_BUFFER;
+    m_defaultArrayBuffer->m_size = 0;
+    m_defaultArrayBuffer->m_storageFlags = 0;
+    m_defaultArrayBuffer->m_immutable = false;
 
     m_defaultIndexBuffer = (IndexBuffer*) malloc(sizeof(IndexBuffer));
     m_defaultIndexBuffer->m_id = 0;
     m_defaultIndexBuffer->m_target = GL_ELEMENT_ARRAY_BUFFER;
+    m_defaultIndexBuffer->m_size = 0;
+    m_defaultIndexBuffer->m_storageFlags = 0;
+    m_defaultIndexBuffer->m_immutable = false;
 
     m_defaultUniformBuffer = (UniformBuffer*) malloc(sizeof(UniformBuffer));
     m_defaultUniformBuffer->m_id = 0;
     m_defaultUniformBuffer->m_target = GL_UNIFORM_BUFFER;
+    m_defaultUniformBuffer->m_size = 0;
+    m_defaultUniformBuffer->m_storageFlags = 0;
+    m_defaultUniformBuffer->m_immutable = false;
+
+    m_defaultIndirectBuffer = (IndirectBuffer*) malloc(sizeof(IndirectBuffer));
+    m_defaultIndirectBuffer->m_id = 0;
+    m_defaultIndirectBuffer->m_target = Buffer::DrawIndirect;
+    m_defaultIndirectBuffer->m_size = 0;
+    m_defaultIndirectBuffer->m_storageFlags = 0;
+    m_defaultIndirectBuffer->m_immutable = false;
 
     m_defaultShaderProgram = (ShaderProgram*) malloc(sizeof(ShaderProgram));
     m_defaultShaderProgram->id = 0;
+    m_defaultShaderProgram->m_uniformCache = nullptr;
+    m_defaultShaderProgram->m_idsCount = 0;
 
     m_defaultInputLayout = (InputLayout*) malloc(sizeof(InputLayout));
     m_defaultInputLayout->m_id = 0;
@@ -118,9 +164,11 @@ void Engine::init() {
     m_boundRenderbuffer = m_defaultRenderbuffer;
     m_boundTexture2D = m_defaultTexture2D;
     m_boundTextureCube = m_defaultTextureCube;
+    m_boundTextureBuffer = m_defaultTextureBuffer;
     m_boundArrayBuffer = m_defaultArrayBuffer;
     m_boundIndexBuffer = m_defaultIndexBuffer;
     m_boundUniformBuffer = m_defaultUniformBuffer;
+    m_boundIndirectBuffer = m_defaultIndirectBuffer;
     m_boundShaderProgram = m_defaultShaderProgram;
     m_boundInputLayout = m_defaultInputLayout;
 
@@ -134,9 +182,11 @@ void Engine::destroy() {
     free(m_defaultRenderbuffer);
     free(m_defaultTexture2D);
     free(m_defaultTextureCube);
+    free(m_defaultTextureBuffer);
     free(m_defaultArrayBuffer);
     free(m_defaultIndexBuffer);
     free(m_defaultUniformBuffer);
+    free(m_defaultIndirectBuffer);
     free(m_defaultShaderProgram);
     free(m_defaultInputLayout);
 
@@ -176,9 +226,11 @@ returnBound(Framebuffer, getBoundFramebuffer, m_boundFramebuffer, m_defaultFrame
 returnBound(Renderbuffer, getBoundRenderbuffer, m_boundRenderbuffer, m_defaultRenderbuffer)
 returnBound(Texture2D, getBoundTexture2D, m_boundTexture2D, m_defaultTexture2D)
 returnBound(TextureCube, getBoundTextureCube, m_boundTextureCube, m_defaultTextureCube)
+returnBound(TextureBuffer, getBoundTextureBuffer, m_boundTextureBuffer, m_defaultTextureBuffer)
 returnBound(ArrayBuffer, getBoundArrayBuffer, m_boundArrayBuffer, m_defaultArrayBuffer)
 returnBound(IndexBuffer, getBoundIndexBuffer, m_boundIndexBuffer, m_defaultIndexBuffer)
 returnBound(UniformBuffer, getBoundUniformBuffer, m_boundUniformBuffer, m_defaultUniformBuffer)
+returnBound(IndirectBuffer, getBoundIndirectBuffer, m_boundIndirectBuffer, m_defaultIndirectBuffer)
 returnBound(ShaderProgram, getBoundShaderProgram, m_boundShaderProgram, m_defaultShaderProgram)
 returnBound(InputLayout, getBoundInputLayout, m_boundInputLayout, m_defaultInputLayout)
 #else
@@ -188,9 +240,11 @@ returnNull(Framebuffer, getBoundFramebuffer)
 returnNull(Renderbuffer, getBoundRenderbuffer)
 returnNull(Texture2D, getBoundTexture2D)
 returnNull(TextureCube, getBoundTextureCube)
+returnNull(TextureBuffer, getBoundTextureBuffer)
 returnNull(ArrayBuffer, getBoundArrayBuffer)
 returnNull(IndexBuffer, getBoundIndexBuffer)
 returnNull(UniformBuffer, getBoundUniformBuffer)
+returnNull(IndirectBuffer, getBoundIndirectBuffer)
 returnNull(ShaderProgram, getBoundShaderProgram)
 returnNull(InputLayout, getBoundInputLayout)
 #endif
@@ -203,6 +257,19 @@ string Engine::getGPURenderer() {
     return reinterpret_cast<char const*>(glGetString(GL_RENDERER));
 }
 
+bool Engine::isExtensionSupported(const string &name) {
+    int count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    for (int i = 0; i < count; i++) {
+        if (name == reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, i))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 uint Engine::getError() {
     return glGetError();
 }
@@ -213,9 +280,11 @@ returnDefault(Framebuffer, defaultFramebuffer, m_defaultFramebuffer)
 returnDefault(Renderbuffer, defaultRenderbuffer, m_defaultRenderbuffer)
 returnDefault(Texture2D, defaultTexture2D, m_defaultTexture2D)
 returnDefault(TextureCube, defaultTextureCube, m_defaultTextureCube)
+returnDefault(TextureBuffer, defaultTextureBuffer, m_defaultTextureBuffer)
 returnDefault(ArrayBuffer, defaultArrayBuffer, m_defaultArrayBuffer)
 returnDefault(IndexBuffer, defaultIndexBuffer, m_defaultIndexBuffer)
 returnDefault(UniformBuffer, defaultUniformBuffer, m_defaultUniformBuffer)
+returnDefault(IndirectBuffer, defaultIndirectBuffer, m_defaultIndirectBuffer)
 returnDefault(ShaderProgram, defaultShaderProgram, m_defaultShaderProgram)
 returnDefault(InputLayout, defaultInputLayout, m_defaultInputLayout)
 
@@ -247,6 +316,10 @@ void Engine::drawElements(uint start, uint count, uint polyType) {
     glDrawElements(polyType, count, GL_UNSIGNED_INT, reinterpret_cast<void*>(start * sizeof(uint)));
 }
 
+void Engine::drawElementsInstanced(uint start, uint count, uint instanceCount, uint polyType) {
+    glDrawElementsInstanced(polyType, count, GL_UNSIGNED_INT, reinterpret_cast<void*>(start * sizeof(uint)), instanceCount);
+}
+
 void Engine::setDepthTestMode(uint mode) {
     glDepthFunc(mode);
 }
@@ -286,6 +359,9 @@ void Engine::setBoundObject(uint type, const void *obj) {
         case SOPConstants::TextureCubeObject:
             m_boundTextureCube = (TextureCube*) obj;
             break;
+        case SOPConstants::TextureBufferObject:
+            m_boundTextureBuffer = (TextureBuffer*) obj;
+            break;
         case SOPConstants::ArrayBufferObject:
             m_boundArrayBuffer = (ArrayBuffer*) obj;
             break;
@@ -295,6 +371,9 @@ void Engine::setBoundObject(uint type, const void *obj) {
         case SOPConstants::UniformBufferObject:
             m_boundUniformBuffer = (UniformBuffer*) obj;
             break;
+        case SOPConstants::IndirectBufferObject:
+            m_boundIndirectBuffer = (IndirectBuffer*) obj;
+            break;
         case SOPConstants::ShaderProgramObject:
             m_boundShaderProgram = (ShaderProgram*) obj;
             break;
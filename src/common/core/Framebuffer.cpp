@@ -1,6 +1,7 @@
 #include <algine/core/Framebuffer.h>
 
 #include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
 
 #include <algine/gl.h>
 
@@ -31,17 +32,18 @@ Framebuffer::Framebuffer()
 
 Framebuffer::~Framebuffer() {
     glDeleteFramebuffers(1, &m_id);
+    StateCache::onFramebufferDeleted(m_id);
 }
 
 void Framebuffer::bind() const {
     commitBinding()
-    glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+    StateCache::bindFramebuffer(m_id);
 }
 
 void Framebuffer::unbind() const {
     checkBinding()
     commitUnbinding()
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    StateCache::bindFramebuffer(0);
 }
 
 void Framebuffer::attachTexture(const Texture2DPtr &texture, Attachment attachment) {
@@ -79,8 +81,25 @@ void Framebuffer::resizeAttachments(uint width, uint height) {
     };
 
     resize(m_renderbufferAttachments);
-    resize(m_texture2DAttachments);
-    resize(m_textureCubeAttachments);
+
+    // immutable textures are recreated on resize, so they must be attached again
+    auto resizeTextures = [&](const auto &m)
+    {
+        for (const auto & [attachment, texture] : m) {
+            uint id = texture->getId();
+
+            texture->bind();
+            texture->setDimensions(width, height);
+            texture->update();
+
+            if (texture->getId() != id) {
+                attachTexture(texture, attachment);
+            }
+        }
+    };
+
+    resizeTextures(m_texture2DAttachments);
+    resizeTextures(m_textureCubeAttachments);
 }
 
 void Framebuffer::setActiveOutputList(Index index) {
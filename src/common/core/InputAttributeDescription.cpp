@@ -40,4 +40,12 @@ uint InputAttributeDescription::getOffset() const {
 void InputAttributeDescription::setOffset(const uint offset) {
     m_offset = offset;
 }
+
+void InputAttributeDescription::setDivisor(const uint divisor) {
+    m_divisor = divisor;
+}
+
+uint InputAttributeDescription::getDivisor() const {
+    return m_divisor;
+}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <algine/core/InputLayout.h>
 
 #include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
 
 #include <algine/gl.h>
 
@@ -22,17 +23,18 @@ InputLayout::InputLayout(): m_id() {
 
 InputLayout::~InputLayout() {
     glDeleteVertexArrays(1, &m_id);
+    StateCache::onVertexArrayDeleted(m_id);
 }
 
 void InputLayout::bind() const {
     commitBinding()
-    glBindVertexArray(m_id);
+    StateCache::bindVertexArray(m_id);
 }
 
 void InputLayout::unbind() const {
     checkBinding()
     commitUnbinding()
-    glBindVertexArray(0);
+    StateCache::bindVertexArray(0);
 }
 
 void InputLayout::addAttribute(
@@ -76,6 +78,9 @@ void InputLayout::addAttribute(
             break;
     }
 
+    if (inputAttribDescription.m_divisor != 0)
+        glVertexAttribDivisor(inputAttribDescription.m_location, inputAttribDescription.m_divisor);
+
     arrayBuffer->unbind();
 }
 
@@ -83,4 +88,8 @@ void InputLayout::setIndexBuffer(const IndexBuffer *indexBuffer) const {
     checkBinding()
     indexBuffer->bind();
 }
+
+uint InputLayout::getId() const {
+    return m_id;
+}
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include <algine/core/RenderQueue.h>
+
+#include <algine/core/Engine.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+namespace algine {
+constexpr uint radixBits = 8;
+constexpr uint radixSize = 1u << radixBits;
+constexpr uint noMaterial = -1;
+
+inline std::uint64_t bits(std::uint64_t value, uint count) {
+    return value & ((static_cast<std::uint64_t>(1) << count) - 1);
+}
+
+uint RenderQueue::Stats::total() const {
+    return programChanges + materialChanges + inputLayoutChanges;
+}
+
+void RenderQueue::clear() {
+    m_items.clear();
+    m_keys.clear();
+    m_order.clear();
+}
+
+void RenderQueue::submit(const Item &item) {
+    m_items.emplace_back(item);
+}
+
+void RenderQueue::sort() {
+    auto count = static_cast<uint>(m_items.size());
+
+    m_order.resize(count);
+    std::iota(m_order.begin(), m_order.end(), 0);
+
+    m_unsortedStats = countChanges();
+
+    m_keys.resize(count);
+
+    for (uint i = 0; i < count; i++) {
+        const auto &item = m_items[i];
+        m_keys[i] = makeKey(item, isPassTransparent(item.pass), m_depthNear, m_depthFar);
+    }
+
+    // LSD radix sort, stable; digits which are equal for all keys are skipped
+    m_keysTmp.resize(count);
+    m_orderTmp.resize(count);
+
+    uint histogram[radixSize];
+
+    for (uint shift = 0; shift < sizeof(std::uint64_t) * 8; shift += radixBits) {
+        std::fill(std::begin(histogram), std::end(histogram), 0);
+
+        for (auto key : m_keys)
+            histogram[(key >> shift) & (radixSize - 1)]++;
+
+        if (count == 0 || histogram[(m_keys[0] >> shift) & (radixSize - 1)] == count)
+            continue;
+
+        uint offset = 0;
+
+        for (auto &bucket : histogram) {
+            uint bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+
+        for (uint i = 0; i < count; i++) {
+            uint dst = histogram[(m_keys[i] >> shift) & (radixSize - 1)]++;
+            m_keysTmp[dst] = m_keys[i];
+            m_orderTmp[dst] = m_order[i];
+        }
+
+        m_keys.swap(m_keysTmp);
+        m_order.swap(m_orderTmp);
+    }
+
+    m_sortedStats = countChanges();
+}
+
+void RenderQueue::execute() {
+    ShaderProgram *program = nullptr;
+    InputLayout *inputLayout = nullptr;
+    uint material = noMaterial;
+
+    for (uint index : m_order) {
+        const auto &item = m_items[index];
+
+        if (item.program != program) {
+            program = item.program;
+            program->bind();
+
+            // material uniforms belong to the program
+            material = noMaterial;
+        }
+
+        if (item.inputLayout != inputLayout) {
+            inputLayout = item.inputLayout;
+            inputLayout->bind();
+        }
+
+        if (item.material != material) {
+            material = item.material;
+
+            if (m_materialCallback) {
+                m_materialCallback(program, material);
+            }
+        }
+
+        if (m_drawCallback)
+            m_drawCallback(program, item);
+
+        Engine::drawElements(item.start, item.count);
+    }
+
+    if (inputLayout != nullptr)
+        inputLayout->unbind();
+
+    if (program != nullptr) {
+        program->unbind();
+    }
+}
+
+void RenderQueue::setPassTransparent(uint pass, bool transparent) {
+    if (transparent) {
+        m_transparentPasses |= 1u << pass;
+    } else {
+        m_transparentPasses &= ~(1u << pass);
+    }
+}
+
+bool RenderQueue::isPassTransparent(uint pass) const {
+    return m_transparentPasses & (1u << pass);
+}
+
+void RenderQueue::setDepthRange(float near, float far) {
+    m_depthNear = near;
+    m_depthFar = far;
+}
+
+void RenderQueue::setMaterialCallback(const MaterialCallback &callback) {
+    m_materialCallback = callback;
+}
+
+void RenderQueue::setDrawCallback(const DrawCallback &callback) {
+    m_drawCallback = callback;
+}
+
+uint RenderQueue::getItemsCount() const {
+    return m_items.size();
+}
+
+const RenderQueue::Stats& RenderQueue::getUnsortedStats() const {
+    return m_unsortedStats;
+}
+
+const RenderQueue::Stats& RenderQueue::getSortedStats() const {
+    return m_sortedStats;
+}
+
+std::uint64_t RenderQueue::makeKey(const Item &item, bool transparent, float near, float far) {
+    float depth = std::clamp((item.depth - near) / (far - near), 0.0f, 1.0f);
+
+    std::uint64_t pass = bits(item.pass, 4) << 60u;
+    std::uint64_t program = item.program->getId();
+    std::uint64_t inputLayout = item.inputLayout->getId();
+    std::uint64_t material = item.material;
+
+    if (transparent) {
+        auto invDepth = static_cast<std::uint64_t>((1.0f - depth) * static_cast<float>(bits(~std::uint64_t(0), 24)));
+
+        return pass | invDepth << 36u | bits(program, 12) << 24u | bits(material, 12) << 12u | bits(inputLayout, 12);
+    } else {
+        auto depthBits = static_cast<std::uint64_t>(depth * static_cast<float>(bits(~std::uint64_t(0), 20)));
+
+        return pass | bits(program, 12) << 48u | bits(material, 16) << 32u | bits(inputLayout, 12) << 20u | depthBits;
+    }
+}
+
+RenderQueue::Stats RenderQueue::countChanges() const {
+    Stats stats {};
+
+    const ShaderProgram *program = nullptr;
+    const InputLayout *inputLayout = nullptr;
+    uint material = noMaterial;
+
+    for (uint index : m_order) {
+        const auto &item = m_items[index];
+
+        if (item.program != program) {
+            program = item.program;
+            material = noMaterial;
+            stats.programChanges++;
+        }
+
+        if (item.inputLayout != inputLayout) {
+            inputLayout = item.inputLayout;
+            stats.inputLayoutChanges++;
+        }
+
+        if (item.material != material) {
+            material = item.material;
+            stats.materialChanges++;
+        }
+    }
+
+    return stats;
+}
+}
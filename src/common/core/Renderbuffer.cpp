@@ -2,6 +2,7 @@
 
 #include <algine/core/texture/Texture.h>
 #include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
 
 #include <algine/gl.h>
 
@@ -30,11 +31,12 @@ Renderbuffer::Renderbuffer()
 
 Renderbuffer::~Renderbuffer() {
     glDeleteRenderbuffers(1, &m_id);
+    StateCache::onRenderbufferDeleted(m_id);
 }
 
 void Renderbuffer::bind() {
     commitBinding()
-    glBindRenderbuffer(GL_RENDERBUFFER, m_id);
+    StateCache::bindRenderbuffer(m_id);
 }
 
 void Renderbuffer::setFormat(uint format) {
@@ -62,7 +64,7 @@ void Renderbuffer::update() {
 void Renderbuffer::unbind() {
     checkBinding()
     commitUnbinding()
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    StateCache::bindRenderbuffer(0);
 }
 
 uint Renderbuffer::getFormat() const {
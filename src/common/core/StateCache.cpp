@@ -0,0 +1,221 @@
+#include <algine/core/StateCache.h>
+
+#include <algine/core/texture/TextureBuffer.h>
+#include <algine/gl.h>
+
+namespace algine {
+constexpr uint Unknown = -1;
+constexpr uint MaxTextureUnits = 32;
+
+enum BufferTarget {
+    ArrayBufferTarget,
+    IndexBufferTarget,
+    UniformBufferTarget,
+    BufferTargetsCount
+};
+
+enum TextureTarget {
+    Texture2DTarget,
+    TextureCubeTarget,
+    TextureBufferTarget,
+    TextureTargetsCount
+};
+
+inline int getBufferTarget(uint target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER: return ArrayBufferTarget;
+        case GL_ELEMENT_ARRAY_BUFFER: return IndexBufferTarget;
+        case GL_UNIFORM_BUFFER: return UniformBufferTarget;
+        default: return -1;
+    }
+}
+
+inline int getTextureTarget(uint target) {
+    switch (target) {
+        case GL_TEXTURE_2D: return Texture2DTarget;
+        case GL_TEXTURE_CUBE_MAP: return TextureCubeTarget;
+        case TextureBuffer::Target: return TextureBufferTarget;
+        default: return -1;
+    }
+}
+
+struct State {
+    uint buffers[BufferTargetsCount];
+    uint textures[MaxTextureUnits][TextureTargetsCount];
+    uint activeTexture;
+    uint program;
+    uint vertexArray;
+    uint framebuffer;
+    uint renderbuffer;
+};
+
+static State state;
+static bool enabled = true;
+static uint elidedCalls = 0;
+static uint issuedCalls = 0;
+
+/**
+ * @return true if the call must be issued
+ */
+inline bool update(uint &cached, uint value) {
+    if (enabled && cached == value) {
+        elidedCalls++;
+        return false;
+    }
+
+    cached = value;
+    issuedCalls++;
+
+    return true;
+}
+
+inline void forget(uint &cached, uint id) {
+    if (cached == id) {
+        cached = Unknown;
+    }
+}
+
+void StateCache::bindBuffer(uint target, uint id) {
+    if (int index = getBufferTarget(target); index != -1) {
+        if (!update(state.buffers[index], id)) {
+            return;
+        }
+    } else {
+        issuedCalls++;
+    }
+
+    glBindBuffer(target, id);
+}
+
+// glBindBufferBase & glBindBufferRange also bind buffer to the generic binding point
+
+void StateCache::bindBufferBase(uint target, uint index, uint id) {
+    if (int cacheIndex = getBufferTarget(target); cacheIndex != -1)
+        state.buffers[cacheIndex] = id;
+
+    issuedCalls++;
+    glBindBufferBase(target, index, id);
+}
+
+void StateCache::bindBufferRange(uint target, uint index, uint id, uint offset, uint size) {
+    if (int cacheIndex = getBufferTarget(target); cacheIndex != -1)
+        state.buffers[cacheIndex] = id;
+
+    issuedCalls++;
+    glBindBufferRange(target, index, id, offset, size);
+}
+
+void StateCache::bindTexture(uint target, uint id) {
+    int index = getTextureTarget(target);
+
+    if (index != -1 && state.activeTexture < MaxTextureUnits) {
+        if (!update(state.textures[state.activeTexture][index], id)) {
+            return;
+        }
+    } else {
+        issuedCalls++;
+    }
+
+    glBindTexture(target, id);
+}
+
+void StateCache::activeTexture(uint slot) {
+    if (update(state.activeTexture, slot)) {
+        glActiveTexture(GL_TEXTURE0 + slot);
+    }
+}
+
+void StateCache::useProgram(uint id) {
+    if (update(state.program, id)) {
+        glUseProgram(id);
+    }
+}
+
+void StateCache::bindVertexArray(uint id) {
+    if (update(state.vertexArray, id)) {
+        glBindVertexArray(id);
+
+        // index buffer binding is a part of the vertex array state
+        state.buffers[IndexBufferTarget] = Unknown;
+    }
+}
+
+void StateCache::bindFramebuffer(uint id) {
+    if (update(state.framebuffer, id)) {
+        glBindFramebuffer(GL_FRAMEBUFFER, id);
+    }
+}
+
+void StateCache::bindRenderbuffer(uint id) {
+    if (update(state.renderbuffer, id)) {
+        glBindRenderbuffer(GL_RENDERBUFFER, id);
+    }
+}
+
+void StateCache::onBufferDeleted(uint id) {
+    for (auto &buffer : state.buffers) {
+        forget(buffer, id);
+    }
+}
+
+void StateCache::onTextureDeleted(uint id) {
+    for (auto &unit : state.textures) {
+        for (auto &texture : unit) {
+            forget(texture, id);
+        }
+    }
+}
+
+void StateCache::onProgramDeleted(uint id) {
+    forget(state.program, id);
+}
+
+void StateCache::onVertexArrayDeleted(uint id) {
+    forget(state.vertexArray, id);
+    state.buffers[IndexBufferTarget] = Unknown;
+}
+
+void StateCache::onFramebufferDeleted(uint id) {
+    forget(state.framebuffer, id);
+}
+
+void StateCache::onRenderbufferDeleted(uint id) {
+    forget(state.renderbuffer, id);
+}
+
+void StateCache::invalidate() {
+    for (auto &buffer : state.buffers)
+        buffer = Unknown;
+
+    for (auto &unit : state.textures)
+        for (auto &texture : unit)
+            texture = Unknown;
+
+    state.activeTexture = Unknown;
+    state.program = Unknown;
+    state.vertexArray = Unknown;
+    state.framebuffer = Unknown;
+    state.renderbuffer = Unknown;
+}
+
+void StateCache::setEnabled(bool isEnabled) {
+    enabled = isEnabled;
+}
+
+bool StateCache::isEnabled() {
+    return enabled;
+}
+
+uint StateCache::getElidedCalls() {
+    return elidedCalls;
+}
+
+uint StateCache::getIssuedCalls() {
+    return issuedCalls;
+}
+
+void StateCache::resetCounters() {
+    elidedCalls = 0;
+    issuedCalls = 0;
+}
+}
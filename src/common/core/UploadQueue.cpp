@@ -0,0 +1,217 @@
+#include <algine/core/UploadQueue.h>
+
+#include <algine/templates.h>
+#include <algine/gl.h>
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+
+using namespace std;
+
+namespace algine {
+constexpr uint stagingAlignment = 16;
+
+inline uint alignUp(uint value, uint alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+UploadQueue::UploadQueue() {
+    glGenBuffers(1, &m_stagingId);
+}
+
+UploadQueue::~UploadQueue() {
+    for (auto &batch : m_inFlight)
+        glDeleteSync(static_cast<GLsync>(batch.fence));
+
+    glDeleteBuffers(1, &m_stagingId);
+}
+
+UploadQueue::Ticket UploadQueue::enqueue(Buffer *buffer, uint offset, vector<byte> data) {
+    Upload upload {};
+    upload.type = Type::Buffer;
+    upload.data = std::move(data);
+    upload.buffer = buffer;
+    upload.offset = offset;
+
+    return push(std::move(upload));
+}
+
+UploadQueue::Ticket UploadQueue::enqueue(Buffer *buffer, uint offset, uint size, const void *data) {
+    auto bytes = static_cast<const byte*>(data);
+    return enqueue(buffer, offset, vector<byte>(bytes, bytes + size));
+}
+
+UploadQueue::Ticket UploadQueue::enqueue(Texture2D *texture, uint dataFormat, uint dataType, vector<byte> data,
+                                         bool generateMipmap)
+{
+    Upload upload {};
+    upload.type = Type::Texture;
+    upload.data = std::move(data);
+    upload.texture = texture;
+    upload.dataFormat = dataFormat;
+    upload.dataType = dataType;
+    upload.generateMipmap = generateMipmap;
+
+    return push(std::move(upload));
+}
+
+UploadQueue::Ticket UploadQueue::enqueue(Texture2D *texture, const string &path, bool flipImage) {
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load(flipImage);
+    unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+
+    if (!data) {
+        cerr << "Failed to load texture " << path << "\n";
+        return InvalidTicket;
+    }
+
+    uint formats[] = {Texture::Red, Texture::RG, Texture::RGB, Texture::RGBA};
+    uint dataFormat = formats[channels - 1];
+
+    texture->setDimensions(width, height);
+    texture->setFormat(dataFormat);
+
+    enable_if_android(
+        if (channels < 3) {
+            texture->setFormat(Texture::RGB);
+        }
+    )
+
+    auto bytes = reinterpret_cast<const byte*>(data);
+    vector<byte> pixels(bytes, bytes + width * height * channels);
+
+    stbi_image_free(data);
+
+    return enqueue(texture, dataFormat, GL_UNSIGNED_BYTE, std::move(pixels), true);
+}
+
+void UploadQueue::process() {
+    m_processedBytes = 0;
+
+    // batches are finished in order
+    while (!m_inFlight.empty()) {
+        auto fence = static_cast<GLsync>(m_inFlight.front().fence);
+
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            break;
+
+        m_completedTicket = m_inFlight.front().lastTicket;
+
+        glDeleteSync(fence);
+        m_inFlight.pop_front();
+    }
+
+    if (m_pending.empty())
+        return;
+
+    // select uploads which fit into the budget
+    vector<uint> offsets;
+    uint size = 0;
+
+    for (const auto &upload : m_pending) {
+        uint offset = alignUp(size, stagingAlignment);
+        uint end = offset + static_cast<uint>(upload.data.size());
+
+        if (!offsets.empty() && end > m_frameBudget)
+            break;
+
+        offsets.emplace_back(offset);
+        size = end;
+    }
+
+    m_stagingSize = std::max(m_stagingSize, size);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, m_stagingId);
+
+    // orphaning: the previous frame uploads can still be in progress
+    glBufferData(GL_COPY_READ_BUFFER, m_stagingSize, nullptr, GL_STREAM_DRAW);
+
+    if (size > 0) {
+        auto staging = static_cast<byte*>(
+                glMapBufferRange(GL_COPY_READ_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+        for (usize i = 0; i < offsets.size(); i++) {
+            const auto &data = m_pending[i].data;
+            memcpy(staging + offsets[i], data.data(), data.size());
+        }
+
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+    }
+
+    for (usize i = 0; i < offsets.size(); i++) {
+        const auto &upload = m_pending[i];
+
+        if (upload.type == Type::Buffer) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, upload.buffer->getId());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                                offsets[i], upload.offset, upload.data.size());
+        } else {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_stagingId);
+
+            upload.texture->bind();
+            upload.texture->update(upload.dataFormat, upload.dataType, reinterpret_cast<const void*>(static_cast<usize>(offsets[i])));
+
+            if (upload.generateMipmap)
+                glGenerateMipmap(GL_TEXTURE_2D);
+
+            upload.texture->unbind();
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    Batch batch {};
+    batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    batch.lastTicket = m_pending[offsets.size() - 1].ticket;
+    m_inFlight.emplace_back(batch);
+
+    for (usize i = 0; i < offsets.size(); i++) {
+        m_pendingBytes -= m_pending.front().data.size();
+        m_pending.pop_front();
+    }
+
+    m_processedBytes = size;
+}
+
+bool UploadQueue::isComplete(Ticket ticket) const {
+    return ticket <= m_completedTicket;
+}
+
+void UploadQueue::setFrameBudget(uint budget) {
+    m_frameBudget = budget;
+}
+
+uint UploadQueue::getFrameBudget() const {
+    return m_frameBudget;
+}
+
+uint UploadQueue::getPendingCount() const {
+    return m_pending.size();
+}
+
+uint UploadQueue::getPendingBytes() const {
+    return m_pendingBytes;
+}
+
+uint UploadQueue::getInFlightCount() const {
+    return m_inFlight.size();
+}
+
+uint UploadQueue::getProcessedBytes() const {
+    return m_processedBytes;
+}
+
+UploadQueue::Ticket UploadQueue::push(Upload upload) {
+    upload.ticket = ++m_lastTicket;
+    m_pendingBytes += upload.data.size();
+    m_pending.emplace_back(std::move(upload));
+
+    return m_lastTicket;
+}
+}
@@ -2,15 +2,48 @@
 
 #include <tulz/macros.h>
 
+#include <algorithm>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
 using namespace std;
 using namespace tulz;
 
-#define allocated_block true
-#define free_block false
-#define is_block_allocated(index) m_bufferMap[index]
-#define is_block_free(index) !m_bufferMap[index]
-
 namespace algine {
+typedef std::uint64_t Word;
+
+constexpr uint wordBits = sizeof(Word) * 8;
+
+/// @param word - must not be 0
+inline uint findFirstSet(Word word) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<uint>(index);
+#elif defined(_MSC_VER)
+    unsigned long index;
+
+    if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+        return static_cast<uint>(index);
+
+    _BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+    return static_cast<uint>(index) + 32;
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint>(__builtin_ctzll(word));
+#else
+    uint index = 0;
+
+    while (!(word & 1u)) {
+        word >>= 1;
+        index++;
+    }
+
+    return index;
+#endif
+}
+
 BlockBufferStorage::~BlockBufferStorage() {
     deletePtr(m_buffer)
 }
@@ -32,49 +65,41 @@ void BlockBufferStorage::allocateStorage() {
     reallocateStorage();
 }
 
-template<typename T1, typename T2> inline T1 min(T1 t1, T2 t2) {
-    return t1 > t2 ? t2 : t1;
-}
-
 void BlockBufferStorage::reallocateStorage() {
-    if (m_blocksCount != m_bufferMap.size()) {
-        auto newBufferMap = Array<bool>(m_blocksCount);
-        uint oldBlocksCount = min(m_blocksCount, m_bufferMap.size());
-
-        for (uint i = 0; i < oldBlocksCount; i++)
-            newBufferMap[i] = m_bufferMap[i];
-
-        for (uint i = oldBlocksCount; i < m_blocksCount; i++)
-            newBufferMap[i] = free_block;
-
-        m_bufferMap = newBufferMap;
-    }
-
-    // reallocate buffer & copy old data
-    uint oldSize = m_buffer->size();
-    uint newSize = storageSize;
-    uint dataToCopySize = min(oldSize, newSize);
-
-    auto data = m_buffer->getData(0, dataToCopySize);
-
-    m_buffer->setData(storageSize, nullptr, m_usage);
-    m_buffer->updateData(0, dataToCopySize, data.array());
+    if (m_blocksCount != m_mapSize)
+        resizeMap(m_blocksCount);
 
+    // data is copied on the GPU side, without read back
+    m_buffer->reallocate(storageSize, m_usage);
 }
 
 void BlockBufferStorage::allocateBlock(uint blockIndex) {
-    m_bufferMap[blockIndex] = allocated_block;
+    setBlockFree(blockIndex, false);
 }
 
 void BlockBufferStorage::freeBlock(uint blockIndex) {
-    m_bufferMap[blockIndex] = free_block;
+    setBlockFree(blockIndex, true);
 }
 
 uint BlockBufferStorage::allocateBlock() {
-    for (uint i = 0; i < m_bufferMap.size(); i++) {
-        if (is_block_free(i)) {
-            m_bufferMap[i] = allocated_block;
-            return i;
+    if (m_freeBlocksCount == 0) {
+        if (!m_autoGrowth)
+            return StorageFull;
+
+        m_blocksCount = std::max(m_blocksCount * 2, 1u);
+
+        m_buffer->bind();
+        reallocateStorage();
+    }
+
+    for (uint i = m_firstFreeWord; i < m_freeMap.size(); i++) {
+        if (m_freeMap[i] != 0) {
+            m_firstFreeWord = i;
+
+            uint index = i * wordBits + findFirstSet(m_freeMap[i]);
+            setBlockFree(index, false);
+
+            return index;
         }
     }
 
@@ -89,36 +114,84 @@ void BlockBufferStorage::write(uint blockIndex, uint offset, uint size, const vo
     m_buffer->updateData(blockIndex * m_blockSize + offset, size, data);
 }
 
-inline int getFirstBlockType(Array<bool> &map, int lastBlock, bool type) {
-    for (uint i = lastBlock + 1; i < map.size(); i++)
-        if (map[i] == type)
-            return i;
-
-    return -1;
-}
-
 vector<BlockBufferStorage::DefragmentationInfo> BlockBufferStorage::defragmentMap() {
     vector<DefragmentationInfo> infos;
 
-    int freeBlock = -1;
-    int allocatedBlock = 0;
+    if (m_mapSize == 0)
+        return infos;
+
+    // move the last allocated blocks to the first free ones
+    uint freeBlock = 0;
+    uint allocatedBlock = m_mapSize - 1;
 
     while (true) {
-        freeBlock = getFirstBlockType(m_bufferMap, freeBlock, free_block);
-        allocatedBlock = getFirstBlockType(m_bufferMap,
-                freeBlock > allocatedBlock ? freeBlock : allocatedBlock, allocated_block);
-
-        if (freeBlock != -1 && allocatedBlock != -1) {
-            DefragmentationInfo info{};
-            info.oldIndex = allocatedBlock;
-            info.newIndex = freeBlock;
-            infos.emplace_back(info);
-
-            swap(m_bufferMap[freeBlock], m_bufferMap[allocatedBlock]);
-        } else {
+        while (freeBlock < m_mapSize && !isBlockFree(freeBlock))
+            freeBlock++;
+
+        while (allocatedBlock > freeBlock && isBlockFree(allocatedBlock))
+            allocatedBlock--;
+
+        if (freeBlock >= allocatedBlock)
             return infos;
+
+        DefragmentationInfo info{};
+        info.oldIndex = allocatedBlock;
+        info.newIndex = freeBlock;
+        infos.emplace_back(info);
+
+        setBlockFree(freeBlock, false);
+        setBlockFree(allocatedBlock, true);
+    }
+}
+
+vector<BlockBufferStorage::DefragmentationInfo> BlockBufferStorage::compact(bool shrink) {
+    auto infos = defragmentMap();
+
+    // moves go to the ascending free blocks from the descending allocated ones,
+    // so runs of adjacent blocks are copied at once, keeping their order
+    for (usize i = 0; i < infos.size();) {
+        usize end = i + 1;
+
+        while (end < infos.size() &&
+               infos[end].newIndex == infos[end - 1].newIndex + 1 &&
+               infos[end].oldIndex + 1 == infos[end - 1].oldIndex)
+        {
+            end++;
+        }
+
+        auto count = static_cast<uint>(end - i);
+        uint oldStart = infos[end - 1].oldIndex;
+
+        Buffer::copy(m_buffer, m_buffer,
+                     getBlockOffset(oldStart), getBlockOffset(infos[i].newIndex),
+                     count * m_blockSize);
+
+        for (uint j = 0; j < count; j++) {
+            infos[i + j].oldIndex = oldStart + j;
+        }
+
+        i = end;
+    }
+
+    if (m_remapCallback) {
+        for (const auto &info : infos) {
+            m_remapCallback(info.oldIndex, info.newIndex);
         }
     }
+
+    if (shrink) {
+        uint allocatedCount = m_mapSize - m_freeBlocksCount;
+        uint blocksCount = std::max(allocatedCount, 1u) * 2;
+
+        if (blocksCount < m_blocksCount) {
+            m_blocksCount = blocksCount;
+
+            m_buffer->bind();
+            reallocateStorage();
+        }
+    }
+
+    return infos;
 }
 
 void BlockBufferStorage::setBlockSize(uint size, uint alignment) {
@@ -139,6 +212,14 @@ void BlockBufferStorage::setBufferUsage(uint usage) {
     m_usage = usage;
 }
 
+void BlockBufferStorage::setAutoGrowth(bool autoGrowth) {
+    m_autoGrowth = autoGrowth;
+}
+
+void BlockBufferStorage::setRemapCallback(const RemapCallback &callback) {
+    m_remapCallback = callback;
+}
+
 uint BlockBufferStorage::capacity() const {
     return storageSize;
 }
@@ -159,6 +240,14 @@ uint BlockBufferStorage::getBufferUsage() const {
     return m_usage;
 }
 
+uint BlockBufferStorage::getFreeBlocksCount() const {
+    return m_freeBlocksCount;
+}
+
+bool BlockBufferStorage::isAutoGrowth() const {
+    return m_autoGrowth;
+}
+
 uint BlockBufferStorage::getBlockOffset(uint index) const {
     return m_blockSize * index;
 }
@@ -170,8 +259,8 @@ Buffer* BlockBufferStorage::getBuffer() const {
 vector<uint> BlockBufferStorage::getFreeBlocks() const {
     vector<uint> freeBlocks;
 
-    for (uint i = 0; i < m_bufferMap.size(); i++)
-        if (is_block_free(i))
+    for (uint i = 0; i < m_mapSize; i++)
+        if (isBlockFree(i))
             freeBlocks.emplace_back(i);
 
     return freeBlocks;
@@ -180,18 +269,53 @@ vector<uint> BlockBufferStorage::getFreeBlocks() const {
 vector<uint> BlockBufferStorage::getAllocatedBlocks() const {
     vector<uint> allocatedBlocks;
 
-    for (uint i = 0; i < m_bufferMap.size(); i++)
-        if (is_block_allocated(i))
+    for (uint i = 0; i < m_mapSize; i++)
+        if (!isBlockFree(i))
             allocatedBlocks.emplace_back(i);
 
     return allocatedBlocks;
 }
 
 bool BlockBufferStorage::isBlockFree(uint index) const {
-    return is_block_free(index);
+    return (m_freeMap[index / wordBits] >> (index % wordBits)) & 1u;
 }
 
-const Array<bool>& BlockBufferStorage::getBufferMap() const {
-    return m_bufferMap;
+Array<bool> BlockBufferStorage::getBufferMap() const {
+    auto map = Array<bool>(m_mapSize);
+
+    for (uint i = 0; i < m_mapSize; i++)
+        map[i] = !isBlockFree(i);
+
+    return map;
+}
+
+void BlockBufferStorage::setBlockFree(uint index, bool free) {
+    auto &word = m_freeMap[index / wordBits];
+    Word bit = static_cast<Word>(1) << (index % wordBits);
+
+    if (free && !(word & bit)) {
+        word |= bit;
+        m_freeBlocksCount++;
+        m_firstFreeWord = std::min(m_firstFreeWord, index / wordBits);
+    } else if (!free && (word & bit)) {
+        word &= ~bit;
+        m_freeBlocksCount--;
+    }
+}
+
+void BlockBufferStorage::resizeMap(uint blocksCount) {
+    // drop blocks which are out of the new size
+    for (uint i = blocksCount; i < m_mapSize; i++)
+        setBlockFree(i, false);
+
+    uint oldSize = std::min(m_mapSize, blocksCount);
+
+    m_freeMap.resize((blocksCount + wordBits - 1) / wordBits, 0);
+    m_mapSize = blocksCount;
+    m_firstFreeWord = std::min(m_firstFreeWord, static_cast<uint>(m_freeMap.size()));
+
+    for (uint i = oldSize; i < blocksCount; i++) {
+        setBlockFree(i, true);
+    }
 }
 }
@@ -1,10 +1,13 @@
 #include <algine/core/buffers/Buffer.h>
 
 #include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
 
 #include <algine/templates.h>
 #include <algine/gl.h>
 
+#include <algorithm>
+#include <stdexcept>
 #include <string>
 #include <cassert>
 
@@ -29,6 +32,8 @@ inline void* getBoundBuffer(uint target) {
             return Engine::getBoundIndexBuffer();
         case GL_UNIFORM_BUFFER:
             return Engine::getBoundUniformBuffer();
+        case GL_DRAW_INDIRECT_BUFFER:
+            return Engine::getBoundIndirectBuffer();
         default:
             assert(0);
     }
@@ -42,6 +47,8 @@ inline uint getBufferObject(uint target) {
             return SOPConstants::IndexBufferObject;
         case GL_UNIFORM_BUFFER:
             return SOPConstants::UniformBufferObject;
+        case GL_DRAW_INDIRECT_BUFFER:
+            return SOPConstants::IndirectBufferObject;
         default:
             assert(0);
     }
@@ -55,6 +62,8 @@ inline string getBufferObjectName(uint target) {
             return SOPConstants::IndexBufferStr;
         case GL_UNIFORM_BUFFER:
             return SOPConstants::UniformBufferStr;
+        case GL_DRAW_INDIRECT_BUFFER:
+            return SOPConstants::IndirectBufferStr;
         default:
             assert(0);
     }
@@ -68,22 +77,48 @@ Buffer::Buffer() {
 
 Buffer::~Buffer() {
     glDeleteBuffers(1, &m_id);
+    StateCache::onBufferDeleted(m_id);
 }
 
 void Buffer::bind() const {
     commitBinding()
-    glBindBuffer(m_target, m_id);
+    StateCache::bindBuffer(m_target, m_id);
 }
 
 void Buffer::unbind() const {
     checkBinding()
     commitUnbinding()
-    glBindBuffer(m_target, 0);
+    StateCache::bindBuffer(m_target, 0);
 }
 
 void Buffer::setData(uint size, const void *data, uint usage) {
     checkBinding()
+
+    if (m_immutable)
+        throw runtime_error("Buffer " + to_string(m_id) + " has immutable storage, use reallocate instead");
+
     glBufferData(m_target, size, data, usage);
+    m_size = size;
+}
+
+void Buffer::setStorage(uint size, const void *data, uint flags) {
+    checkBinding()
+
+    if (m_immutable)
+        throw runtime_error("Buffer " + to_string(m_id) + " already has immutable storage");
+
+    if (!isStorageSupported()) {
+        setData(size, data, flags & StorageFlags::DynamicStorage ? DynamicDraw : StaticDraw);
+        return;
+    }
+
+    enable_if_desktop(
+        glBufferStorage(m_target, size, data, flags);
+    )
+
+    m_size = size;
+    m_storageFlags = flags;
+    m_immutable = true;
 }
 
 void Buffer::updateData(uint offset, uint size, const void *data) {
@@ -128,13 +163,55 @@ bool Buffer::unmapData() {
     return glUnmapBuffer(m_target);
 }
 
-uint Buffer::size() const {
+void Buffer::reallocate(uint size, uint usage) {
     checkBinding()
 
-    int size;
-    glGetBufferParameteriv(m_target, GL_BUFFER_SIZE, &size);
+    uint oldSize = this->size();
+
+    if (oldSize == 0 && !m_immutable) {
+        glBufferData(m_target, size, nullptr, usage);
+        m_size = size;
+        return;
+    }
+
+    uint newId;
+    glGenBuffers(1, &newId);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newId);
+
+    // immutable buffer keeps its storage flags
+    if (m_immutable) {
+        enable_if_desktop(
+            glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, m_storageFlags);
+        )
+    } else {
+        glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, usage);
+    }
 
-    return size;
+    glBindBuffer(GL_COPY_READ_BUFFER, m_id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, std::min(oldSize, size));
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &m_id);
+    StateCache::onBufferDeleted(m_id);
+
+    m_id = newId;
+    m_size = size;
+    StateCache::bindBuffer(m_target, m_id);
+}
+
+void Buffer::copy(const Buffer *src, Buffer *dst, uint srcOffset, uint dstOffset, uint size) {
+    glBindBuffer(GL_COPY_READ_BUFFER, src->m_id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, dst->m_id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, size);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+uint Buffer::size() const {
+    return m_size;
 }
 
 uint Buffer::getId() const {
@@ -145,6 +222,20 @@ uint Buffer::getType() const {
     return m_target;
 }
 
+bool Buffer::isImmutable() const {
+    return m_immutable;
+}
+
+bool Buffer::isStorageSupported() {
+    enable_if_desktop(
+        return Engine::getAPIVersion() >= 440 || Engine::isExtensionSupported("GL_ARB_buffer_storage");
+    )
+
+    enable_if_android(
+        return false;
+    )
+}
+
 Buffer::Buffer(uint target): Buffer() {
     m_target = target;
 }
@@ -0,0 +1,107 @@
+#include <algine/core/buffers/BufferMirror.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+namespace algine {
+void BufferMirror::resize(uint size) {
+    m_data.resize(size, 0);
+
+    // GPU storage content is undefined, so the whole buffer must be
+    // uploaded once; otherwise zero writes would be skipped
+    m_dirtyRanges.clear();
+
+    if (size > 0) {
+        m_dirtyRanges.push_back({0, size});
+    }
+}
+
+void BufferMirror::write(uint offset, uint size, const void *data) {
+    if (static_cast<usize>(offset) + size > m_data.size()) {
+        throw invalid_argument(
+            "BufferMirror: write out of range: offset " + to_string(offset) + ", size " + to_string(size) +
+            ", mirror size " + to_string(m_data.size()));
+    }
+
+    m_frameStats.writes++;
+    m_frameStats.writtenBytes += size;
+
+    byte *dst = m_data.data() + offset;
+
+    if (memcmp(dst, data, size) == 0)
+        return;
+
+    memcpy(dst, data, size);
+
+    // the most common case: sequential writes of the neighbour fields
+    if (!m_dirtyRanges.empty() && m_dirtyRanges.back().end == offset) {
+        m_dirtyRanges.back().end = offset + size;
+    } else {
+        m_dirtyRanges.push_back({offset, offset + size});
+    }
+}
+
+void BufferMirror::flush(Buffer *buffer) {
+    if (!m_dirtyRanges.empty()) {
+        std::sort(m_dirtyRanges.begin(), m_dirtyRanges.end(), [](const Range &lhs, const Range &rhs) {
+            return lhs.begin < rhs.begin;
+        });
+
+        auto upload = [&](const Range &range) {
+            uint size = range.end - range.begin;
+            buffer->updateData(range.begin, size, m_data.data() + range.begin);
+
+            m_frameStats.uploads++;
+            m_frameStats.uploadedBytes += size;
+        };
+
+        Range current = m_dirtyRanges.front();
+
+        for (usize i = 1; i < m_dirtyRanges.size(); i++) {
+            const auto &range = m_dirtyRanges[i];
+
+            if (range.begin <= current.end + m_mergeGap) {
+                current.end = std::max(current.end, range.end);
+            } else {
+                upload(current);
+                current = range;
+            }
+        }
+
+        upload(current);
+
+        m_dirtyRanges.clear();
+    }
+
+    m_stats = m_frameStats;
+    m_frameStats = Stats();
+}
+
+void BufferMirror::setMergeGap(uint gap) {
+    m_mergeGap = gap;
+}
+
+uint BufferMirror::getMergeGap() const {
+    return m_mergeGap;
+}
+
+uint BufferMirror::size() const {
+    return m_data.size();
+}
+
+const byte* BufferMirror::data() const {
+    return m_data.data();
+}
+
+bool BufferMirror::isDirty() const {
+    return !m_dirtyRanges.empty();
+}
+
+const BufferMirror::Stats& BufferMirror::getStats() const {
+    return m_stats;
+}
+}
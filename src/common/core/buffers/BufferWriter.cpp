@@ -17,7 +17,27 @@ void BufferWriter::end() {
 }
 
 void BufferWriter::write(uint offset, uint size, const void *data) {
-    m_buffer->updateData(offset, size, data);
+    if (m_mirrorEnabled) {
+        m_mirror.write(offset, size, data);
+    } else {
+        m_buffer->updateData(offset, size, data);
+    }
+}
+
+void BufferWriter::enableMirror(uint bufferSize) {
+    m_mirror.resize(bufferSize);
+    m_mirrorEnabled = true;
+}
+
+void BufferWriter::disableMirror() {
+    m_mirror = BufferMirror();
+    m_mirrorEnabled = false;
+}
+
+void BufferWriter::flush() {
+    if (m_mirrorEnabled) {
+        m_mirror.flush(m_buffer);
+    }
 }
 
 void BufferWriter::setBuffer(Buffer *buffer) {
@@ -27,4 +47,16 @@ void BufferWriter::setBuffer(Buffer *buffer) {
 Buffer* BufferWriter::getBuffer() const {
     return m_buffer;
 }
+
+bool BufferWriter::isMirrorEnabled() const {
+    return m_mirrorEnabled;
+}
+
+const BufferMirror& BufferWriter::getMirror() const {
+    return m_mirror;
+}
+
+BufferMirror& BufferWriter::mirror() {
+    return m_mirror;
+}
 }
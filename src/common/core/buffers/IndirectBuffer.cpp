@@ -0,0 +1,6 @@
+#include <algine/core/buffers/IndirectBuffer.h>
+
+namespace algine {
+IndirectBuffer::IndirectBuffer()
+    : Buffer(Buffer::DrawIndirect) {}
+}
@@ -0,0 +1,207 @@
+#include <algine/core/buffers/StreamBuffer.h>
+
+#include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
+
+#include <algine/templates.h>
+#include <algine/gl.h>
+
+#include <stdexcept>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+namespace algine {
+inline uint alignUp(uint value, uint alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+constexpr uint64 waitTimeout = 1000000; // 1 ms
+
+StreamBuffer::StreamBuffer() = default;
+
+StreamBuffer::~StreamBuffer() {
+    deleteFences();
+    deletePtr(m_buffer)
+}
+
+void StreamBuffer::init(uint frameSize, uint alignment, Mode mode) {
+    deleteFences();
+
+    // immutable storage can't be reallocated, so the buffer is recreated
+    deletePtr(m_buffer)
+    m_mapped = nullptr;
+    m_mappedRange = false;
+
+    m_alignment = std::max(alignment, 1u);
+    m_frameSize = alignUp(frameSize, m_alignment);
+    m_mode = mode == Mode::Persistent && isPersistentMappingSupported() ? Mode::Persistent : Mode::Orphaning;
+    m_frame = FramesCount - 1;
+    m_frameOffset = 0;
+
+    uint size = m_frameSize * FramesCount;
+
+    m_buffer = new UniformBuffer();
+    m_buffer->bind();
+
+    if (m_mode == Mode::Persistent) {
+        uint flags = Buffer::StorageFlags::MapWrite | Buffer::StorageFlags::MapPersistent | Buffer::StorageFlags::MapCoherent;
+        m_buffer->setStorage(size, nullptr, flags);
+        m_mapped = static_cast<byte*>(m_buffer->mapData(0, size, flags));
+
+        // mapping failed, immutable storage can't be reused, so fall back to orphaning
+        if (m_mapped == nullptr) {
+            m_buffer->unbind();
+            deletePtr(m_buffer)
+
+            m_mode = Mode::Orphaning;
+            m_buffer = new UniformBuffer();
+            m_buffer->bind();
+        }
+    }
+
+    if (m_mode == Mode::Orphaning) {
+        m_buffer->setData(size, nullptr, Buffer::StreamDraw);
+    }
+
+    m_buffer->unbind();
+}
+
+void StreamBuffer::beginFrame() {
+    m_frame = (m_frame + 1) % FramesCount;
+    m_frameOffset = 0;
+
+    if (m_mode == Mode::Persistent) {
+        waitFence(m_frame);
+    } else if (m_frame == 0) {
+        // GPU can still read previous regions, so take a new storage
+        m_buffer->bind();
+        m_buffer->setData(m_frameSize * FramesCount, nullptr, Buffer::StreamDraw);
+        m_buffer->unbind();
+    }
+}
+
+void StreamBuffer::endFrame() {
+    if (m_mode == Mode::Persistent) {
+        m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+StreamBuffer::Range StreamBuffer::allocate(uint size) {
+    // buffer can't be mapped twice
+    if (m_mappedRange)
+        throw runtime_error("StreamBuffer: the previous range must be committed before the next allocation");
+
+    uint offset = alignUp(m_frameOffset, m_alignment);
+
+    if (offset + size > m_frameSize)
+        throw runtime_error("StreamBuffer: frame region overflow, frame size is " + to_string(m_frameSize));
+
+    m_frameOffset = offset + size;
+
+    Range range;
+    range.offset = m_frame * m_frameSize + offset;
+    range.size = size;
+
+    if (m_mode == Mode::Persistent) {
+        range.data = m_mapped + range.offset;
+    } else {
+        uint access = Buffer::MapMode::Write | Buffer::MapMode::InvalidateRange | Buffer::MapMode::Unsinchronized;
+
+        m_buffer->bind();
+        range.data = m_buffer->mapData(range.offset, size, access);
+        m_buffer->unbind();
+
+        if (range.data == nullptr)
+            throw runtime_error("StreamBuffer: range mapping failed");
+
+        m_mappedRange = true;
+    }
+
+    return range;
+}
+
+void StreamBuffer::commit(const Range &range) {
+    // coherent mapping makes writes visible without explicit flush
+    if (m_mode == Mode::Orphaning && m_mappedRange) {
+        m_buffer->bind();
+        m_buffer->unmapData();
+        m_buffer->unbind();
+
+        m_mappedRange = false;
+    }
+}
+
+StreamBuffer::Range StreamBuffer::write(const void *data, uint size) {
+    auto range = allocate(size);
+    memcpy(range.data, data, size);
+    commit(range);
+
+    return range;
+}
+
+// Engine::defaultUniformBuffer()->bind(): see BaseUniformBlock::linkBuffer
+
+void StreamBuffer::bindRange(uint bindingPoint, const Range &range) const {
+    StateCache::bindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, m_buffer->getId(), range.offset, range.size);
+    Engine::defaultUniformBuffer()->bind();
+}
+
+StreamBuffer::Mode StreamBuffer::getMode() const {
+    return m_mode;
+}
+
+UniformBuffer* StreamBuffer::getBuffer() const {
+    return m_buffer;
+}
+
+uint StreamBuffer::getFrameSize() const {
+    return m_frameSize;
+}
+
+uint StreamBuffer::getFrameIndex() const {
+    return m_frame;
+}
+
+uint StreamBuffer::getUsedSize() const {
+    return m_frameOffset;
+}
+
+uint StreamBuffer::getWaitsCount() const {
+    return m_waitsCount;
+}
+
+void StreamBuffer::resetWaitsCount() {
+    m_waitsCount = 0;
+}
+
+bool StreamBuffer::isPersistentMappingSupported() {
+    return Buffer::isStorageSupported();
+}
+
+void StreamBuffer::waitFence(Index frame) {
+    auto fence = static_cast<GLsync>(m_fences[frame]);
+
+    if (fence == nullptr)
+        return;
+
+    if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+        m_waitsCount++;
+
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, waitTimeout) == GL_TIMEOUT_EXPIRED);
+    }
+
+    glDeleteSync(fence);
+    m_fences[frame] = nullptr;
+}
+
+void StreamBuffer::deleteFences() {
+    for (auto &fence : m_fences) {
+        if (fence != nullptr) {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+}
+}
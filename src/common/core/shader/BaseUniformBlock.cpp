@@ -1,6 +1,7 @@
 #include <algine/core/shader/BaseUniformBlock.h>
 
 #include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
 
 #include <algine/gl.h>
 
@@ -28,12 +29,12 @@ void BaseUniformBlock::allocateSuitableBufferSize() {
 // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBindBufferBase.xhtml
 
 void BaseUniformBlock::linkBuffer() const {
-    glBindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint, m_uniformBuffer->m_id);
+    StateCache::bindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint, m_uniformBuffer->m_id);
     Engine::defaultUniformBuffer()->bind();
 }
 
 void BaseUniformBlock::linkBuffer(const uint offset, const uint size) const {
-    glBindBufferRange(GL_UNIFORM_BUFFER, m_bindingPoint, m_uniformBuffer->m_id, offset, size);
+    StateCache::bindBufferRange(GL_UNIFORM_BUFFER, m_bindingPoint, m_uniformBuffer->m_id, offset, size);
     Engine::defaultUniformBuffer()->bind();
 }
 
@@ -57,6 +58,10 @@ void BaseUniformBlock::setBindingPoint(const uint bindingPoint) {
     m_bindingPoint = bindingPoint;
 }
 
+void BaseUniformBlock::setSize(uint size) {
+    m_blockSize = size;
+}
+
 
 UniformBuffer* BaseUniformBlock::getBuffer() const {
     return m_uniformBuffer;
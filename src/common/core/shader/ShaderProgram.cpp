@@ -2,13 +2,16 @@
 
 #include <algine/core/shader/ShaderTools.h>
 #include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
 
 #include <algine/gl.h>
 
 #include <tulz/File.h>
+#include <tulz/macros.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 #define SOP_BOUND_PTR Engine::m_boundShaderProgram
@@ -26,12 +29,19 @@ using namespace algine::internal;
 
 namespace algine {
 vector<ShaderProgramPtr> ShaderProgram::publicObjects;
+ShaderProgram* ShaderProgram::m_current;
 
 ShaderProgram::ShaderProgram()
     : id(glCreateProgram()) {}
 
 ShaderProgram::~ShaderProgram() {
     glDeleteProgram(id);
+    StateCache::onProgramDeleted(id);
+
+    if (m_current == this)
+        m_current = nullptr;
+
+    deletePtr(m_uniformCache)
 }
 
 void ShaderProgram::fromSource(const string &vertex, const string &fragment, const string &geometry) {
@@ -83,11 +93,24 @@ void ShaderProgram::link() {
     if (!infoLog.empty()) {
         cerr << "Info log of ShaderProgram with id " << id << ": " << infoLog;
     }
+
+    // linking resets uniforms to their default values
+    invalidateUniformCache();
+}
+
+void ShaderProgram::setTransformFeedbackVaryings(const vector<string> &varyings, uint mode) {
+    vector<const char*> names;
+    names.reserve(varyings.size());
+
+    for (const auto &varying : varyings)
+        names.emplace_back(varying.c_str());
+
+    glTransformFeedbackVaryings(id, static_cast<int>(names.size()), names.data(), mode);
 }
 
 void ShaderProgram::loadUniformLocation(const string &name) {
     if (locations.find(name) == locations.end()) {
-        locations[name] = glGetUniformLocation(id, name.c_str());
+        addLocation(name, glGetUniformLocation(id, name.c_str()));
     }
 }
 
@@ -99,7 +122,7 @@ void ShaderProgram::loadUniformLocations(const vector<string> &names) {
 
 void ShaderProgram::loadAttribLocation(const string &name) {
     if (locations.find(name) == locations.end()) {
-        locations[name] = glGetAttribLocation(id, name.c_str());
+        addLocation(name, glGetAttribLocation(id, name.c_str()));
     }
 }
 
@@ -156,51 +179,137 @@ int ShaderProgram::getLocation(const string &name) {
 
     return -1;
 #else
-    return locations[name];
+    auto it = locations.find(name);
+    return it == locations.end() ? -1 : it->second;
 #endif
 }
 
+int ShaderProgram::getLocation(UniformId name) const {
+    if (m_idLocations.empty())
+        return -1;
+
+    uint mask = m_idLocations.size() - 1;
+
+    for (uint i = name.getHash() & mask;; i = (i + 1) & mask) {
+        const auto &slot = m_idLocations[i];
+
+        if (slot.hash == name.getHash()) {
+            return slot.location;
+        } else if (slot.hash == 0) {
+            break;
+        }
+    }
+
+#ifdef ALGINE_SECURE_OPERATIONS
+    ALGINE_SOP_ERROR(
+        "Variable with hash " + to_string(name.getHash()) + " does not exist in program with id " + to_string(id) + "\n"
+        "Maybe you have forgotten to call loadActiveLocations() first?"
+    );
+#endif
+
+    return -1;
+}
+
 void ShaderProgram::bind() {
     commitBinding()
-    glUseProgram(id);
+    StateCache::useProgram(id);
+
+    // default program is created without ctor, so it's not tracked
+    m_current = id == 0 ? nullptr : this;
 }
 
 void ShaderProgram::unbind() {
     checkBinding()
     commitUnbinding()
-    glUseProgram(0);
+    StateCache::useProgram(0);
+    m_current = nullptr;
+}
+
+void ShaderProgram::setUniformCacheEnabled(bool enabled) {
+    if (enabled && m_uniformCache == nullptr) {
+        m_uniformCache = new UniformCache();
+    } else if (!enabled) {
+        deletePtr(m_uniformCache)
+    }
+}
+
+bool ShaderProgram::isUniformCacheEnabled() const {
+    return m_uniformCache != nullptr;
+}
+
+void ShaderProgram::invalidateUniformCache() {
+    if (m_uniformCache != nullptr) {
+        m_uniformCache->invalidate();
+    }
+}
+
+const UniformCache* ShaderProgram::getUniformCache() const {
+    return m_uniformCache;
+}
+
+bool ShaderProgram::updateCache(int location, const void *data, uint size) {
+    if (m_current == nullptr || m_current->m_uniformCache == nullptr)
+        return true;
+
+    return m_current->m_uniformCache->update(location, data, size);
 }
 
 void ShaderProgram::setBool(const int location, const bool p) {
-    glUniform1i(location, p);
+    int value = p;
+
+    if (updateCache(location, &value, sizeof(value)))
+        glUniform1i(location, value);
 }
 
 void ShaderProgram::setInt(const int location, const int p) {
-    glUniform1i(location, p);
+    if (updateCache(location, &p, sizeof(p)))
+        glUniform1i(location, p);
 }
 
 void ShaderProgram::setUint(const int location, const uint p) {
-    glUniform1ui(location, p);
+    if (updateCache(location, &p, sizeof(p)))
+        glUniform1ui(location, p);
 }
 
 void ShaderProgram::setFloat(const int location, const float p) {
-    glUniform1f(location, p);
+    if (updateCache(location, &p, sizeof(p)))
+        glUniform1f(location, p);
 }
 
 void ShaderProgram::setVec3(const int location, const glm::vec3 &p) {
-    glUniform3fv(location, 1, glm::value_ptr(p));
+    if (updateCache(location, glm::value_ptr(p), sizeof(p)))
+        glUniform3fv(location, 1, glm::value_ptr(p));
 }
 
 void ShaderProgram::setVec4(const int location, const glm::vec4 &p) {
-    glUniform4fv(location, 1, glm::value_ptr(p));
+    if (updateCache(location, glm::value_ptr(p), sizeof(p)))
+        glUniform4fv(location, 1, glm::value_ptr(p));
+}
+
+void ShaderProgram::setVec4(const int location, const uint count, const glm::vec4 *p) {
+    // each element is cached under its own location, since
+    // elements can also be set one by one
+    bool changed = location < 0;
+
+    if (!changed) {
+        for (uint i = 0; i < count; i++) {
+            changed |= updateCache(location + static_cast<int>(i), glm::value_ptr(p[i]), sizeof(glm::vec4));
+        }
+    }
+
+    if (changed) {
+        glUniform4fv(location, count, glm::value_ptr(*p));
+    }
 }
 
 void ShaderProgram::setMat3(const int location, const glm::mat3 &p) {
-    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(p));
+    if (updateCache(location, glm::value_ptr(p), sizeof(p)))
+        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(p));
 }
 
 void ShaderProgram::setMat4(const int location, const glm::mat4 &p) {
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(p));
+    if (updateCache(location, glm::value_ptr(p), sizeof(p)))
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(p));
 }
 
 void ShaderProgram::setBool(const string &location, const bool p) {
@@ -233,6 +342,11 @@ void ShaderProgram::setVec4(const string &location, const glm::vec4 &p) {
     setVec4(getLocation(location), p);
 }
 
+void ShaderProgram::setVec4(const string &location, const uint count, const glm::vec4 *p) {
+    checkBinding()
+    setVec4(getLocation(location), count, p);
+}
+
 void ShaderProgram::setMat3(const string &location, const glm::mat3 &p) {
     checkBinding()
     setMat3(getLocation(location), p);
@@ -243,10 +357,98 @@ void ShaderProgram::setMat4(const string &location, const glm::mat4 &p) {
     setMat4(getLocation(location), p);
 }
 
+void ShaderProgram::setBool(UniformId location, bool p) {
+    checkBinding()
+    setBool(getLocation(location), p);
+}
+
+void ShaderProgram::setInt(UniformId location, int p) {
+    checkBinding()
+    setInt(getLocation(location), p);
+}
+
+void ShaderProgram::setUint(UniformId location, uint p) {
+    checkBinding()
+    setUint(getLocation(location), p);
+}
+
+void ShaderProgram::setFloat(UniformId location, float p) {
+    checkBinding()
+    setFloat(getLocation(location), p);
+}
+
+void ShaderProgram::setVec3(UniformId location, const glm::vec3 &p) {
+    checkBinding()
+    setVec3(getLocation(location), p);
+}
+
+void ShaderProgram::setVec4(UniformId location, const glm::vec4 &p) {
+    checkBinding()
+    setVec4(getLocation(location), p);
+}
+
+void ShaderProgram::setVec4(UniformId location, uint count, const glm::vec4 *p) {
+    checkBinding()
+    setVec4(getLocation(location), count, p);
+}
+
+void ShaderProgram::setMat3(UniformId location, const glm::mat3 &p) {
+    checkBinding()
+    setMat3(getLocation(location), p);
+}
+
+void ShaderProgram::setMat4(UniformId location, const glm::mat4 &p) {
+    checkBinding()
+    setMat4(getLocation(location), p);
+}
+
 uint ShaderProgram::getId() const {
     return id;
 }
 
+void ShaderProgram::addLocation(const string &name, int location) {
+    locations[name] = location;
+
+    // keep load factor <= 0.5
+    if ((m_idsCount + 1) * 2 > m_idLocations.size()) {
+        auto slots = std::move(m_idLocations);
+
+        m_idLocations.assign(std::max<usize>(16, slots.size() * 2), {0, 0});
+        m_idsCount = 0;
+
+        for (const auto &slot : slots) {
+            if (slot.hash != 0) {
+                uint mask = m_idLocations.size() - 1;
+                uint i = slot.hash & mask;
+
+                while (m_idLocations[i].hash != 0)
+                    i = (i + 1) & mask;
+
+                m_idLocations[i] = slot;
+                m_idsCount++;
+            }
+        }
+    }
+
+    uint hash = UniformId::hash(name.c_str());
+    uint mask = m_idLocations.size() - 1;
+    uint i = hash & mask;
+
+    while (m_idLocations[i].hash != 0 && m_idLocations[i].hash != hash)
+        i = (i + 1) & mask;
+
+    if (m_idLocations[i].hash == hash) {
+        if (m_idLocations[i].location != location) {
+            cerr << "ShaderProgram " << id << ": hash collision of " << name << "\n";
+        }
+
+        return;
+    }
+
+    m_idLocations[i] = {hash, location};
+    m_idsCount++;
+}
+
 ShaderProgramPtr ShaderProgram::getByName(const string &name) {
     return PublicObjectTools::getByName<ShaderProgramPtr>(name);
 }
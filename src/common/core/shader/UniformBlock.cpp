@@ -4,6 +4,8 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstring>
+
 using namespace std;
 using namespace tulz;
 using namespace glm;
@@ -86,7 +88,11 @@ uint UniformBlock::getVarIndex(uint position, const ShaderProgram *shaderProgram
 // Definitions are not generated to keep things simple (first of all debugging)
 
 void UniformBlock::write(uint position, uint size, const void *data) {
-    m_uniformBuffer->updateData(m_varOffsets[position], size, data);
+    if (m_mirrorEnabled) {
+        m_mirror.write(m_varOffsets[position], size, data);
+    } else {
+        m_uniformBuffer->updateData(m_varOffsets[position], size, data);
+    }
 }
 
 void UniformBlock::writeBool(uint position, bool p) {
@@ -156,4 +162,32 @@ void UniformBlock::writeMat3(const string &name, const mat3 &p) {
 void UniformBlock::writeMat4(const string &name, const mat4 &p) {
     writeMat4(getVarPosition(name), p);
 }
+
+void UniformBlock::write(const StreamBuffer::Range &range, uint position, uint size, const void *data) const {
+    memcpy(static_cast<byte*>(range.data) + m_varOffsets[position], data, size);
+}
+
+void UniformBlock::enableMirror() {
+    m_mirror.resize(m_blockSize);
+    m_mirrorEnabled = true;
+}
+
+void UniformBlock::disableMirror() {
+    m_mirror = BufferMirror();
+    m_mirrorEnabled = false;
+}
+
+void UniformBlock::flush() {
+    if (m_mirrorEnabled) {
+        m_mirror.flush(m_uniformBuffer);
+    }
+}
+
+bool UniformBlock::isMirrorEnabled() const {
+    return m_mirrorEnabled;
+}
+
+const BufferMirror& UniformBlock::getMirror() const {
+    return m_mirror;
+}
 }
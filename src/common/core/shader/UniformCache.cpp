@@ -0,0 +1,58 @@
+#include <algine/core/shader/UniformCache.h>
+
+#include <cstring>
+
+namespace algine {
+bool UniformCache::update(int location, const void *data, uint size) {
+    if (location < 0)
+        return true;
+
+    if (location >= m_entries.size())
+        m_entries.resize(location + 1, {0, 0, 0});
+
+    auto &entry = m_entries[location];
+
+    if (entry.size == size && memcmp(&m_values[entry.offset], data, size) == 0) {
+        m_hits++;
+        return false;
+    }
+
+    // size changes only for arrays, old bytes are not reused
+    if (entry.capacity < size) {
+        entry.offset = m_values.size();
+        entry.capacity = size;
+        m_values.resize(m_values.size() + size);
+    }
+
+    entry.size = size;
+    memcpy(&m_values[entry.offset], data, size);
+
+    m_misses++;
+
+    return true;
+}
+
+void UniformCache::invalidate() {
+    m_entries.clear();
+    m_values.clear();
+}
+
+void UniformCache::invalidate(int location) {
+    if (location >= 0 && location < m_entries.size()) {
+        m_entries[location].size = 0;
+    }
+}
+
+uint UniformCache::getHits() const {
+    return m_hits;
+}
+
+uint UniformCache::getMisses() const {
+    return m_misses;
+}
+
+void UniformCache::resetCounters() {
+    m_hits = 0;
+    m_misses = 0;
+}
+}
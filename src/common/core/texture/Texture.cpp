@@ -1,7 +1,10 @@
 #include <algine/core/texture/Texture.h>
 
+#include <algine/core/texture/TextureBuffer.h>
 #include <algine/core/Engine.h>
+#include <algine/core/StateCache.h>
 
+#include <algorithm>
 #include <iostream>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -9,6 +12,8 @@
 
 #include "internal/SOP.h"
 
+#include "TexturePrivateTools.h"
+
 using namespace algine;
 using namespace std;
 
@@ -25,6 +30,8 @@ inline void* getBoundTexture(const uint target) {
             return Engine::getBoundTexture2D();
         case GL_TEXTURE_CUBE_MAP:
             return Engine::getBoundTextureCube();
+        case TextureBuffer::Target:
+            return Engine::getBoundTextureBuffer();
         default:
             assert(0);
     }
@@ -36,6 +43,8 @@ inline uint getTextureObject(const uint target) {
             return SOPConstants::Texture2DObject;
         case GL_TEXTURE_CUBE_MAP:
             return SOPConstants::TextureCubeObject;
+        case TextureBuffer::Target:
+            return SOPConstants::TextureBufferObject;
         default:
             assert(0);
     }
@@ -47,6 +56,8 @@ inline string getTextureObjectName(const uint target) {
             return SOPConstants::Texture2DStr;
         case GL_TEXTURE_CUBE_MAP:
             return SOPConstants::TextureCubeStr;
+        case TextureBuffer::Target:
+            return SOPConstants::TextureBufferStr;
         default:
             assert(0);
     }
@@ -64,23 +75,24 @@ Texture::Texture(uint target): Texture() {
 
 Texture::~Texture() {
     glDeleteTextures(1, &m_id);
+    StateCache::onTextureDeleted(m_id);
 }
 
 void Texture::bind() const {
     commitBinding()
-    glBindTexture(m_target, m_id);
+    StateCache::bindTexture(m_target, m_id);
 }
 
 void Texture::unbind() const {
     checkBinding()
     commitUnbinding()
-    glBindTexture(m_target, 0);
+    StateCache::bindTexture(m_target, 0);
 }
 
 void Texture::use(uint slot) const {
     commitBinding()
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(m_target, m_id);
+    StateCache::activeTexture(slot);
+    StateCache::bindTexture(m_target, m_id);
 }
 
 void Texture::setParams(const map<uint, uint> &params) {
@@ -104,6 +116,7 @@ void Texture::applyTextureCreateInfo(const TextureCreateInfo &createInfo) {
     m_format = createInfo.format;
     m_width = createInfo.width;
     m_height = createInfo.height;
+    m_immutable = createInfo.immutable;
 
     bind();
     setParams(createInfo.params);
@@ -152,8 +165,84 @@ uint Texture::getId() const {
     return m_id;
 }
 
+void Texture::setImmutable(bool immutable) {
+    m_immutable = immutable;
+}
+
+void Texture::setMipLevelsCount(uint count) {
+    m_mipLevels = count;
+}
+
+uint Texture::getMipLevelsCount() const {
+    if (m_mipLevels != 0)
+        return m_mipLevels;
+
+    uint size = std::max(m_width, m_height);
+    uint levels = 1;
+
+    while (size >>= 1u)
+        levels++;
+
+    return levels;
+}
+
+bool Texture::isImmutable() const {
+    return m_immutable && isImmutableStorageSupported();
+}
+
+bool Texture::isImmutableStorageSupported() {
+    enable_if_desktop(
+        return Engine::getAPIVersion() >= 420 || Engine::isExtensionSupported("GL_ARB_texture_storage");
+    )
+
+    enable_if_android(
+        return true;
+    )
+}
+
 void Texture::activateSlot(uint slot) {
-    glActiveTexture(GL_TEXTURE0 + slot);
+    StateCache::activeTexture(slot);
+}
+
+bool Texture::allocateStorage() {
+    checkBinding()
+
+    if (!isImmutable())
+        return false;
+
+    uint format = TexturePrivateTools::getSizedFormat(m_format);
+
+    if (m_storageFormat == format && m_storageWidth == m_width && m_storageHeight == m_height)
+        return true;
+
+    // immutable storage can't be respecified, so the texture is recreated
+    if (m_storageFormat != 0) {
+        constexpr uint paramNames[] = {MinFilter, MagFilter, WrapU, WrapV, WrapW};
+
+        map<uint, uint> params;
+
+        for (uint name : paramNames) {
+            int value;
+            glGetTexParameteriv(m_target, name, &value);
+            params[name] = value;
+        }
+
+        glDeleteTextures(1, &m_id);
+        StateCache::onTextureDeleted(m_id);
+
+        glGenTextures(1, &m_id);
+        StateCache::bindTexture(m_target, m_id);
+
+        setParams(params);
+    }
+
+    glTexStorage2D(m_target, getMipLevelsCount(), format, m_width, m_height);
+
+    m_storageFormat = format;
+    m_storageWidth = m_width;
+    m_storageHeight = m_height;
+
+    return true;
 }
 
 void Texture::texFromFile(const string &path, uint target, DataType dataType, bool flipImage) {
@@ -174,7 +263,12 @@ void Texture::texFromFile(const string &path, uint target, DataType dataType, bo
     )
 
     if (data) {
-        glTexImage2D(target, m_lod, m_format, m_width, m_height, 0, dataFormat, static_cast<uint>(dataType), data);
+        if (allocateStorage()) {
+            glTexSubImage2D(target, m_lod, 0, 0, m_width, m_height, dataFormat, static_cast<uint>(dataType), data);
+        } else {
+            glTexImage2D(target, m_lod, m_format, m_width, m_height, 0, dataFormat, static_cast<uint>(dataType), data);
+        }
+
         glGenerateMipmap(m_target);
     } else {
         cerr << "Failed to load texture " << path << "\n";
@@ -32,6 +32,9 @@ void Texture2D::fromFile(const std::string &path, DataType dataType, bool flipIm
 void Texture2D::update() {
     checkBinding()
 
+    if (allocateStorage())
+        return;
+
     auto [dataFormat, dataType] = TexturePrivateTools::getDataInfo(m_format);
 
     glTexImage2D(m_target, m_lod, m_format, m_width, m_height, 0, dataFormat, static_cast<GLenum>(dataType), nullptr);
@@ -39,7 +42,12 @@ void Texture2D::update() {
 
 void Texture2D::update(const uint dataFormat, const uint dataType, const void *const data) {
     checkBinding()
-    glTexImage2D(m_target, m_lod, m_format, m_width, m_height, 0, dataFormat, dataType, data);
+
+    if (allocateStorage()) {
+        glTexSubImage2D(m_target, m_lod, 0, 0, m_width, m_height, dataFormat, dataType, data);
+    } else {
+        glTexImage2D(m_target, m_lod, m_format, m_width, m_height, 0, dataFormat, dataType, data);
+    }
 }
 
 map<uint, uint> Texture2D::defaultParams() {
@@ -38,6 +38,7 @@ Texture2DPtr Texture2DManager::create() {
     Texture2DPtr texture = make_shared<Texture2D>();
     texture->setName(m_name);
     texture->setFormat(m_format);
+    texture->setImmutable(m_immutable);
 
     texture->bind();
 
@@ -0,0 +1,90 @@
+#include <algine/core/texture/TextureBuffer.h>
+
+#include <algine/core/Engine.h>
+
+#include <stdexcept>
+
+#define SOP_BOUND_PTR Engine::getBoundTextureBuffer()
+#define SOP_OBJECT_TYPE SOPConstants::TextureBufferObject
+#define SOP_OBJECT_ID m_id
+#define SOP_OBJECT_NAME SOPConstants::TextureBufferStr
+#include "internal/SOP.h"
+#include "internal/SOPConstants.h"
+
+#include "TexturePrivateTools.h"
+
+#if !defined(__ANDROID__) || __ANDROID_API__ >= 24
+    #define ALGINE_TEXTURE_BUFFER_SUPPORTED
+#endif
+
+using namespace std;
+
+namespace algine {
+TextureBuffer::TextureBuffer()
+    : Texture(Target)
+{
+    m_format = RGBA32F;
+}
+
+void TextureBuffer::setBuffer(Buffer *buffer) {
+    m_buffer = buffer;
+    update();
+}
+
+void TextureBuffer::update() {
+    checkBinding()
+
+#ifdef ALGINE_TEXTURE_BUFFER_SUPPORTED
+    glTexBuffer(m_target, m_format, m_buffer == nullptr ? 0 : m_buffer->getId());
+#else
+    throw runtime_error("Texture buffers require OpenGL ES 3.2 (Android API 24)");
+#endif
+}
+
+Buffer* TextureBuffer::getBuffer() const {
+    return m_buffer;
+}
+
+uint TextureBuffer::getActualFormat() const {
+    return TexturePrivateTools::getTexParam(m_target, GL_TEXTURE_INTERNAL_FORMAT);
+}
+
+uint TextureBuffer::getActualWidth() const {
+    if (m_buffer == nullptr)
+        return 0;
+
+    m_buffer->bind();
+    uint width = m_buffer->size() / getTexelSize(m_format);
+    m_buffer->unbind();
+
+    return width;
+}
+
+uint TextureBuffer::getActualHeight() const {
+    return 1;
+}
+
+uint TextureBuffer::getTexelSize(uint format) {
+    switch (format) {
+        case Red8:
+            return 1;
+        case RG8:
+        case Red16F:
+            return 2;
+        case RGBA8:
+        case RG16F:
+        case Red32F:
+            return 4;
+        case RGBA16F:
+        case RG32F:
+            return 8;
+        case RGB32F:
+            return 12;
+        case RGBA32F:
+        case RGBA32UI:
+            return 16;
+        default:
+            throw invalid_argument("Unsupported texture buffer format " + to_string(format));
+    }
+}
+}
@@ -32,6 +32,9 @@ void TextureCube::fromFile(const std::string &path, Face face, DataType dataType
 void TextureCube::update() {
     checkBinding()
 
+    if (allocateStorage())
+        return;
+
     auto [dataFormat, dataType] = TexturePrivateTools::getDataInfo(m_format);
 
     for (uint i = 0; i < 6; ++i) {
@@ -54,6 +54,7 @@ TextureCubePtr TextureCubeManager::create() {
     TextureCubePtr texture = make_shared<TextureCube>();
     texture->setName(m_name);
     texture->setFormat(m_format);
+    texture->setImmutable(m_immutable);
 
     texture->bind();
 
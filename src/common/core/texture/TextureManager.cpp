@@ -27,6 +27,10 @@ void TextureManager::setDataType(DataType dataType) {
     m_dataType = dataType;
 }
 
+void TextureManager::setImmutable(bool immutable) {
+    m_immutable = immutable;
+}
+
 void TextureManager::setParams(const map<uint, uint> &params) {
     m_params = params;
 }
@@ -43,6 +47,10 @@ DataType TextureManager::getDataType() const {
     return m_dataType;
 }
 
+bool TextureManager::isImmutable() const {
+    return m_immutable;
+}
+
 const map<uint, uint>& TextureManager::getParams() const {
     return m_params;
 }
@@ -66,6 +74,10 @@ void TextureManager::import(const JsonHelper &jsonHelper) {
     if (config.contains(File) && config[File].contains(Config::DataType))
         m_dataType = stringToDataType(config[File][Config::DataType]);
 
+    // load storage type
+    if (config.contains(Immutable))
+        m_immutable = config[Immutable];
+
     // load params
     if (config.contains(Params)) {
         for (const auto & p : config[Params].items()) {
@@ -90,6 +102,10 @@ JsonHelper TextureManager::dump() {
     if (m_writeFileSection)
         config[File][Config::DataType] = dataTypeToString(m_dataType);
 
+    // write storage type
+    if (m_immutable)
+        config[Immutable] = true;
+
     // write params
     for (const auto & param : m_params)
         config[Params][paramKeyToString(param.first)] = paramValueToString(param.second);
@@ -17,6 +17,19 @@ inline uint getTexParam(const uint target, const uint name) {
     return value;
 }
 
+/// immutable storage requires sized formats
+inline constexpr uint getSizedFormat(uint format) {
+    switch (format) {
+        case Texture::Red: return Texture::Red8;
+        case Texture::RG: return Texture::RG8;
+        case Texture::RGB: return Texture::RGB8;
+        case Texture::RGBA: return Texture::RGBA8;
+        case Texture::DepthComponent: return GL_DEPTH_COMPONENT24;
+        case Texture::DepthStencil: return GL_DEPTH24_STENCIL8;
+        default: return format;
+    }
+}
+
 struct TextureDataInfo {
     uint format;
     DataType type;
@@ -8,6 +8,8 @@ using namespace std;
 using namespace tulz;
 
 namespace algine {
+constexpr UniformId KernelId(BlurShader::Vars::Kernel);
+
 Blur::Blur(const TextureCreateInfo &textureCreateInfo)
     : m_pingpongShaders(),
       m_quadRenderer(),
@@ -38,10 +40,10 @@ void Blur::configureKernel(const uint radius, const float sigma) {
     for (auto & pingpongShader : m_pingpongShaders) {
         pingpongShader->bind();
 
+        int location = pingpongShader->getLocation(KernelId);
+
         for (uint j = 0; j < radius; ++j) {
-            ShaderProgram::setFloat(
-                pingpongShader->getLocation(BlurShader::Vars::Kernel) + static_cast<int>((radius - 1 - j)), kernel[j]
-            );
+            ShaderProgram::setFloat(location + static_cast<int>((radius - 1 - j)), kernel[j]);
         }
     }
 
@@ -53,6 +53,7 @@ constant(RGB32F, "rgb32f");
 constant(RGBA32F, "rgba32f");
 
 constant(Params, "params");
+constant(Immutable, "immutable");
 
 // param keys
 constant(MinFilter, "minFilter");
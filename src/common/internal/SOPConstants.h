@@ -9,9 +9,11 @@ enum {
     RenderbufferObject,
     Texture2DObject,
     TextureCubeObject,
+    TextureBufferObject,
     ArrayBufferObject,
     IndexBufferObject,
     UniformBufferObject,
+    IndirectBufferObject,
     ShaderProgramObject,
     InputLayoutObject
 };
@@ -20,9 +22,11 @@ constant(FramebufferStr, "Framebuffer")
 constant(RenderbufferStr, "Renderbuffer")
 constant(Texture2DStr, "Texture2D")
 constant(TextureCubeStr, "TextureCube")
+constant(TextureBufferStr, "TextureBuffer")
 constant(ArrayBufferStr, "ArrayBuffer")
 constant(IndexBufferStr, "IndexBuffer")
 constant(UniformBufferStr, "UniformBuffer")
+constant(IndirectBufferStr, "IndirectBuffer")
 constant(ShaderProgramStr, "ShaderProgram")
 constant(InputLayoutStr, "InputLayout")
 }
@@ -0,0 +1,245 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/BatchRenderer.h>
+
+#include <algine/constants/BatchRenderer.h>
+#include <algine/std/model/Shape.h>
+#include <algine/core/Engine.h>
+
+#include <algine/templates.h>
+#include <algine/gl.h>
+
+#include <tulz/macros.h>
+
+#include <glm/gtc/type_ptr.hpp>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+constexpr uint drawTexels = 5;
+
+inline void upload(Buffer *buffer, const vector<vec4> &data) {
+    buffer->bind();
+    buffer->setData(sizeof(vec4) * data.size(), value_ptr(data[0]), Buffer::DynamicDraw);
+    buffer->unbind();
+}
+
+inline void attach(TextureBuffer *texture, Buffer *buffer) {
+    texture->bind();
+    texture->setFormat(Texture::RGBA32F);
+    texture->setBuffer(buffer);
+    texture->unbind();
+}
+
+BatchRenderer::BatchRenderer() {
+    m_commandsBuffer = new IndirectBuffer();
+    m_drawsBuffer = new ArrayBuffer();
+    m_materialsBuffer = new ArrayBuffer();
+    m_drawsTexture = new TextureBuffer();
+    m_materialsTexture = new TextureBuffer();
+
+    // texture buffer can't be attached to the buffer without data store
+    vec4 empty[] = {vec4()};
+
+    for (auto buffer : {m_drawsBuffer, m_materialsBuffer}) {
+        buffer->bind();
+        buffer->setData(sizeof(empty), empty, Buffer::DynamicDraw);
+        buffer->unbind();
+    }
+
+    attach(m_drawsTexture, m_drawsBuffer);
+    attach(m_materialsTexture, m_materialsBuffer);
+
+    m_mode = isMultiDrawSupported() ? Mode::MultiDrawIndirect : Mode::Loop;
+}
+
+BatchRenderer::~BatchRenderer() {
+    deletePtr(m_drawsTexture)
+    deletePtr(m_materialsTexture)
+    deletePtr(m_commandsBuffer)
+    deletePtr(m_drawsBuffer)
+    deletePtr(m_materialsBuffer)
+}
+
+void BatchRenderer::begin() {
+    m_draws.clear();
+    m_batches.clear();
+    m_batchIndices.clear();
+}
+
+void BatchRenderer::add(Model *model, Index inputLayoutIndex) {
+    const auto &shape = model->getShape();
+    auto inputLayout = shape->getInputLayout(inputLayoutIndex);
+
+    for (const auto &mesh : shape->getMeshes()) {
+        add(inputLayout, mesh.start, mesh.count, model->transformation(), addMaterial(mesh.material));
+    }
+}
+
+void BatchRenderer::add(InputLayout *inputLayout, uint start, uint count, const mat4 &transform, Index materialIndex) {
+    auto it = m_batchIndices.find(inputLayout);
+
+    if (it == m_batchIndices.end()) {
+        it = m_batchIndices.emplace(inputLayout, m_batches.size()).first;
+        m_batches.push_back({inputLayout, 0, 0});
+    }
+
+    Draw draw;
+    draw.batch = it->second;
+    draw.start = start;
+    draw.count = count;
+    draw.material = materialIndex;
+    draw.transform = transform;
+
+    m_draws.emplace_back(draw);
+    m_batches[draw.batch].drawsCount++;
+}
+
+void BatchRenderer::end() {
+    // draws of each batch must be contiguous: counting sort by batch
+    uint offset = 0;
+
+    for (auto &batch : m_batches) {
+        batch.firstDraw = offset;
+        offset += batch.drawsCount;
+    }
+
+    vector<uint> batchEnds(m_batches.size());
+
+    for (usize i = 0; i < m_batches.size(); i++)
+        batchEnds[i] = m_batches[i].firstDraw;
+
+    m_commands.resize(m_draws.size());
+    m_drawsData.resize(m_draws.size() * drawTexels);
+
+    for (const auto &draw : m_draws) {
+        uint index = batchEnds[draw.batch]++;
+
+        auto &command = m_commands[index];
+        command.count = draw.count;
+        command.instanceCount = 1;
+        command.firstIndex = draw.start;
+        command.baseVertex = 0;
+        command.baseInstance = index;
+
+        vec4 *data = &m_drawsData[index * drawTexels];
+
+        for (int i = 0; i < 4; i++)
+            data[i] = draw.transform[i];
+
+        data[4] = vec4(static_cast<float>(draw.material), 0.0f, 0.0f, 0.0f);
+    }
+
+    if (m_draws.empty())
+        return;
+
+    upload(m_drawsBuffer, m_drawsData);
+
+    if (m_mode == Mode::MultiDrawIndirect) {
+        m_commandsBuffer->bind();
+        m_commandsBuffer->setData(sizeof(DrawCommand) * m_commands.size(), m_commands.data(), Buffer::DynamicDraw);
+        m_commandsBuffer->unbind();
+    }
+
+    if (m_materialsChanged) {
+        upload(m_materialsBuffer, m_materials);
+        m_materialsChanged = false;
+    }
+}
+
+void BatchRenderer::draw(ShaderProgram *program, uint textureSlot) {
+    using namespace Module::BatchRenderer::Vars;
+
+    m_drawCallsCount = 0;
+
+    if (m_draws.empty())
+        return;
+
+    m_drawsTexture->use(textureSlot);
+    m_materialsTexture->use(textureSlot + 1);
+
+    program->setInt(Draws, static_cast<int>(textureSlot));
+    program->setInt(Materials, static_cast<int>(textureSlot + 1));
+
+    int drawOffset = program->getLocation(DrawOffset);
+
+    if (m_mode == Mode::MultiDrawIndirect) {
+        enable_if_desktop(
+            m_commandsBuffer->bind();
+
+            for (const auto &batch : m_batches) {
+                batch.inputLayout->bind();
+                ShaderProgram::setInt(drawOffset, static_cast<int>(batch.firstDraw));
+
+                auto commands = reinterpret_cast<const void*>(batch.firstDraw * sizeof(DrawCommand));
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, commands, batch.drawsCount, 0);
+
+                batch.inputLayout->unbind();
+                m_drawCallsCount++;
+            }
+
+            m_commandsBuffer->unbind();
+        )
+    } else {
+        for (const auto &batch : m_batches) {
+            batch.inputLayout->bind();
+
+            for (uint i = batch.firstDraw; i < batch.firstDraw + batch.drawsCount; i++) {
+                ShaderProgram::setInt(drawOffset, static_cast<int>(i));
+                Engine::drawElements(m_commands[i].firstIndex, m_commands[i].count);
+                m_drawCallsCount++;
+            }
+
+            batch.inputLayout->unbind();
+        }
+    }
+}
+
+Index BatchRenderer::addMaterial(const Material &material) {
+    if (auto it = m_materialIndices.find(material.name); it != m_materialIndices.end())
+        return it->second;
+
+    Index index = m_materials.size();
+
+    m_materials.emplace_back(material.ambientStrength, material.diffuseStrength,
+                             material.specularStrength, material.shininess);
+    m_materialIndices[material.name] = index;
+    m_materialsChanged = true;
+
+    return index;
+}
+
+void BatchRenderer::setMode(Mode mode) {
+    m_mode = mode == Mode::MultiDrawIndirect && isMultiDrawSupported() ? Mode::MultiDrawIndirect : Mode::Loop;
+}
+
+BatchRenderer::Mode BatchRenderer::getMode() const {
+    return m_mode;
+}
+
+uint BatchRenderer::getDrawsCount() const {
+    return m_draws.size();
+}
+
+uint BatchRenderer::getBatchesCount() const {
+    return m_batches.size();
+}
+
+uint BatchRenderer::getMaterialsCount() const {
+    return m_materials.size();
+}
+
+uint BatchRenderer::getDrawCallsCount() const {
+    return m_drawCallsCount;
+}
+
+bool BatchRenderer::isMultiDrawSupported() {
+    enable_if_desktop(
+        return Engine::getAPIVersion() >= 430 && Engine::isExtensionSupported("GL_ARB_shader_draw_parameters");
+    )
+
+    enable_if_android(
+        return false;
+    )
+}
+}
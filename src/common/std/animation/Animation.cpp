@@ -15,5 +15,15 @@ Animation::Animation(const aiAnimation *anim)
     for (uint i = 0; i < anim->mNumChannels; i++) {
         channels.emplace_back(anim->mChannels[i]);
     }
+
+    morphChannels.reserve(anim->mNumMorphMeshChannels);
+
+    for (uint i = 0; i < anim->mNumMorphMeshChannels; i++) {
+        morphChannels.emplace_back(anim->mMorphMeshChannels[i]);
+    }
+}
+
+bool Animation::isCompressed() const {
+    return frameStep != 0.0f;
+}
 }
-}
\ No newline at end of file
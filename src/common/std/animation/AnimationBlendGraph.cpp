@@ -0,0 +1,120 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/AnimationBlendGraph.h>
+
+#include <algine/std/animation/Animator.h>
+#include <algine/std/model/Model.h>
+#include <algine/std/model/Shape.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+AnimationBlendGraph::AnimationBlendGraph(const ModelPtr &model) {
+    setModel(model);
+}
+
+AnimationBlendGraph::AnimationBlendGraph() = default;
+
+void AnimationBlendGraph::evaluate(float timeInSeconds) {
+    const auto &shape = *m_model->getShape();
+
+    shape.getSkeleton().getDefaultPose(m_pose);
+
+    for (Index i = 0; i < m_layers.size(); i++) {
+        const auto &layer = m_layers[i];
+
+        if (layer.weight <= 0.0f)
+            continue;
+
+        float weight = std::min(layer.weight, 1.0f);
+        float time = timeInSeconds * layer.speed + layer.timeOffset;
+
+        Animator::samplePose(shape, layer.animationIndex, time, m_layerPose);
+
+        const LocalPose *reference = layer.mode == BlendMode::Additive ? &getReferencePose(i) : nullptr;
+        const auto &mask = layer.mask;
+
+        for (Index joint = 0; joint < m_pose.size(); joint++) {
+            if (!mask.empty() && !mask.test(joint))
+                continue;
+
+            if (layer.mode == BlendMode::Additive) {
+                m_pose[joint] = JointTransform::add(m_pose[joint], m_layerPose[joint], (*reference)[joint], weight);
+            } else {
+                m_pose[joint] = JointTransform::lerp(m_pose[joint], m_layerPose[joint], weight);
+            }
+        }
+    }
+
+    Animator::computeBones(shape, m_pose, m_model->getBoneTransformations(), m_globals, m_bones);
+
+    m_model->invalidateBones();
+}
+
+Index AnimationBlendGraph::addLayer(const Layer &layer) {
+    m_layers.emplace_back(layer);
+    m_referencePoses.emplace_back();
+    return m_layers.size() - 1;
+}
+
+void AnimationBlendGraph::setLayer(Index index, const Layer &layer) {
+    m_layers[index] = layer;
+    m_referencePoses[index].clear();
+}
+
+void AnimationBlendGraph::setLayerWeight(Index index, float weight) {
+    m_layers[index].weight = weight;
+}
+
+void AnimationBlendGraph::removeLayer(Index index) {
+    m_layers.erase(m_layers.begin() + index);
+    m_referencePoses.erase(m_referencePoses.begin() + index);
+}
+
+void AnimationBlendGraph::removeLayers() {
+    m_layers.clear();
+    m_referencePoses.clear();
+}
+
+void AnimationBlendGraph::setModel(const ModelPtr &model) {
+    m_model = model;
+    m_bones.resize(model->getShape()->getBonesAmount());
+
+    for (auto &pose : m_referencePoses) {
+        pose.clear();
+    }
+}
+
+const AnimationBlendGraph::Layer& AnimationBlendGraph::getLayer(Index index) const {
+    return m_layers[index];
+}
+
+uint AnimationBlendGraph::getLayersCount() const {
+    return m_layers.size();
+}
+
+const ModelPtr& AnimationBlendGraph::getModel() const {
+    return m_model;
+}
+
+const LocalPose& AnimationBlendGraph::getPose() const {
+    return m_pose;
+}
+
+const BoneMatrices& AnimationBlendGraph::bones() const {
+    return m_bones;
+}
+
+const LocalPose& AnimationBlendGraph::getReferencePose(Index layerIndex) {
+    auto &pose = m_referencePoses[layerIndex];
+
+    if (pose.empty()) {
+        const auto &layer = m_layers[layerIndex];
+        Animator::samplePose(*m_model->getShape(), layer.referenceAnimation, layer.referenceTime, pose);
+    }
+
+    return pose;
+}
+}
@@ -4,110 +4,98 @@
 #include <algine/std/model/Model.h>
 #include <algine/std/model/Shape.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace std;
-using namespace glm;
 
 namespace algine {
+uint AnimationBlender::m_skippedEvaluations = 0;
+
 AnimationBlender::AnimationBlender(const ModelPtr &model) {
     setModel(model);
 }
 
 AnimationBlender::AnimationBlender() = default;
 
-mat4 AnimationBlender::blendBones(uint index) const {
-    const auto &shape = m_model->getShape();
+void AnimationBlender::blend(float timeInSeconds) {
+    uint transformationsVersion = m_model->getBoneTransformationsVersion();
 
-    const mat4 &lhs = m_model->m_animBones[m_lhsAnim][index];
-    const mat4 &rhs = m_model->m_animBones[m_rhsAnim][index];
+    // blend parameters and sampled poses have not changed
+    if (!m_changed && timeInSeconds == m_lastTime && transformationsVersion == m_lastTransformationsVersion) {
+        m_skippedEvaluations++;
+        return;
+    }
 
-    const mat4 &boneMatrix = shape->m_bones[index].boneMatrix;
-    const mat4 &inverseBoneMatrix = m_inverseBoneMatrices[index];
+    if (m_changed)
+        updateLayers();
 
-    // extracting bone transformation
-    mat4 lhsTransform = inverseGlobalInverseTransform * lhs * inverseBoneMatrix;
-    mat4 rhsTransform = inverseGlobalInverseTransform * rhs * inverseBoneMatrix;
+    m_graph.evaluate(timeInSeconds);
 
-    // blending lhsTransform and rhsTransform
-    quat lhsQuat = quat_cast(lhsTransform);
-    quat rhsQuat = quat_cast(rhsTransform);
-    quat finalQuat = slerp(lhsQuat, rhsQuat, m_factor);
+    m_lastTime = timeInSeconds;
+    m_lastTransformationsVersion = transformationsVersion;
+    m_changed = false;
+}
+
+void AnimationBlender::updateLayers() {
+    if (m_blendListMode > BlendListInclude) {
+        throw invalid_argument(
+            "Unknown m_blendListMode value: " + to_string(m_blendListMode) + "\n"
+            "Valid values:\n"
+            "  0. AnimationBlender::BlendListDisable\n"
+            "  1. AnimationBlender::BlendListExclude\n"
+            "  2. AnimationBlender::BlendListInclude\n"
+        );
+    }
 
-    vec4 lhsTranslate = lhsTransform[3];
-    vec4 rhsTranslate = rhsTransform[3];
-    vec4 finalTranslate = mix(lhsTranslate, rhsTranslate, m_factor);
+    AnimationBlendGraph::Layer lhs;
+    lhs.animationIndex = m_lhsAnim;
 
-    mat4 transform = mat4_cast(finalQuat);
-    transform[3] = finalTranslate;
+    AnimationBlendGraph::Layer rhs;
+    rhs.animationIndex = m_rhsAnim;
+    rhs.weight = m_factor;
+    rhs.mask = getBlendMask();
 
-    // forming result
-    return shape->getGlobalInverseTransform() * transform * boneMatrix;
+    m_graph.removeLayers();
+    m_graph.addLayer(lhs);
+    m_graph.addLayer(rhs);
 }
 
-void AnimationBlender::blend() {
-    switch (m_blendListMode) {
-        case BlendListDisable: {
-            for (uint i = 0; i < m_bones.size(); i++) {
-                m_bones[i] = blendBones(i);
-            }
+BoneMask AnimationBlender::getBlendMask() const {
+    if (m_blendListMode == BlendListDisable)
+        return BoneMask(); // empty mask affects all joints
 
-            break;
-        }
-        case BlendListInclude:
-        case BlendListExclude: {
-            bool isInclude = m_blendListMode == BlendListInclude;
-
-            for (uint i = 0; i < m_bones.size(); ++i) {
-                bool include = !isInclude;
-
-                for (uint j : m_blendList) {
-                    if (i == j) {
-                        include = isInclude;
-                        break;
-                    }
-                }
-
-                if (include) {
-                    m_bones[i] = blendBones(i);
-                } else {
-                    m_bones[i] = m_model->m_animBones[m_lhsAnim][i];
-                }
-            }
-            break;
-        }
-        default: {
-            throw invalid_argument(
-                "Unknown m_blendListMode value: " + to_string(m_blendListMode) + "\n"
-                "Valid values:\n"
-                "  0. AnimationBlender::BlendListDisable\n"
-                "  1. AnimationBlender::BlendListExclude\n"
-                "  2. AnimationBlender::BlendListInclude\n"
-            );
-        }
-    }
-}
+    const auto &joints = m_model->getShape()->getSkeleton().getJoints();
 
-void AnimationBlender::initInverseBoneMatrices() {
-    const auto &shape = m_model->getShape();
+    BoneMask mask(joints.size());
 
-    m_inverseBoneMatrices.resize(shape->getBonesAmount());
+    for (Index i = 0; i < joints.size(); i++) {
+        Index bone = joints[i].bone;
 
-    for (uint i = 0; i < m_inverseBoneMatrices.size(); ++i) {
-        m_inverseBoneMatrices[i] = inverse(shape->m_bones[i].boneMatrix);
+        if (bone != Skeleton::None && std::find(m_blendList.begin(), m_blendList.end(), bone) != m_blendList.end()) {
+            mask.set(i);
+        }
     }
+
+    if (m_blendListMode == BlendListExclude)
+        mask.invert();
+
+    return mask;
 }
 
 void AnimationBlender::addBlendListItem(const uint item) {
     m_blendList.emplace_back(item);
+    m_changed = true;
 }
 
 void AnimationBlender::setBlendListMode(const uint mode) {
     m_blendListMode = mode;
+    m_changed = true;
 }
 
 void AnimationBlender::setBlendList(const vector<uint> &blendList) {
     m_blendList = blendList;
+    m_changed = true;
 }
 
 inline float checkBounds(const float p, const float lowerBound, const float upperBound) {
@@ -120,28 +108,28 @@ inline float checkFactorBounds(const float factor) {
 
 void AnimationBlender::setFactor(const float factor) {
     m_factor = checkFactorBounds(factor);
+    m_changed = true;
 }
 
 void AnimationBlender::changeFactor(const float step) {
     m_factor = checkFactorBounds(m_factor + step);
+    m_changed = true;
 }
 
 void AnimationBlender::setModel(const ModelPtr &model) {
-    const auto &shape = model->getShape();
-
     m_model = model;
-    m_bones.resize(shape->getBonesAmount());
-    inverseGlobalInverseTransform = inverse(shape->getGlobalInverseTransform());
-
-    initInverseBoneMatrices();
+    m_graph.setModel(model);
+    m_changed = true;
 }
 
 void AnimationBlender::setLhsAnim(const uint index) {
     m_lhsAnim = index;
+    m_changed = true;
 }
 
 void AnimationBlender::setRhsAnim(const uint index) {
     m_rhsAnim = index;
+    m_changed = true;
 }
 
 vector<uint> AnimationBlender::getBlendList() const {
@@ -168,7 +156,15 @@ const ModelPtr& AnimationBlender::getModel() const {
     return m_model;
 }
 
-const vector<mat4>& AnimationBlender::bones() {
-    return m_bones;
+const BoneMatrices& AnimationBlender::bones() const {
+    return m_graph.bones();
+}
+
+uint AnimationBlender::getSkippedEvaluations() {
+    return m_skippedEvaluations;
+}
+
+void AnimationBlender::resetSkippedEvaluations() {
+    m_skippedEvaluations = 0;
 }
 }
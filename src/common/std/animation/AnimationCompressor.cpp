@@ -0,0 +1,239 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/AnimationCompressor.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+using Key = CompressedAnimNode::Key;
+
+constexpr float maxFrame = 65535.0f;
+
+/**
+ * Quantizes source keys and greedily drops the ones that can be
+ * restored by interpolating their neighbours within the tolerance
+ */
+template<typename T, typename Encode, typename Decode, typename Interpolate, typename Distance>
+void reduceKeys(const vector<T> &src, float frameStep, float tolerance, vector<Key> &out,
+                Encode encode, Decode decode, Interpolate interpolate, Distance distance)
+{
+    vector<Key> keys;
+    keys.reserve(src.size());
+
+    for (const auto &srcKey : src) {
+        Key key {};
+        key.frame = static_cast<uint16>(std::round(std::clamp(static_cast<float>(srcKey.time) / frameStep, 0.0f, maxFrame)));
+        encode(srcKey.value, key.value);
+
+        if (!keys.empty() && keys.back().frame == key.frame) {
+            keys.back() = key;
+        } else {
+            keys.emplace_back(key);
+        }
+    }
+
+    if (keys.empty())
+        return;
+
+    vector<decltype(decode(keys[0].value))> values;
+    values.reserve(keys.size());
+
+    for (const auto &key : keys)
+        values.emplace_back(decode(key.value));
+
+    out.clear();
+    out.emplace_back(keys[0]);
+
+    usize start = 0;
+
+    for (usize end = 2; end < keys.size(); end++) {
+        auto frameDelta = static_cast<float>(keys[end].frame - keys[start].frame);
+
+        for (usize i = start + 1; i < end; i++) {
+            float factor = static_cast<float>(keys[i].frame - keys[start].frame) / frameDelta;
+
+            if (distance(interpolate(values[start], values[end], factor), values[i]) > tolerance) {
+                start = end - 1;
+                out.emplace_back(keys[start]);
+                break;
+            }
+        }
+    }
+
+    if (keys.size() > 1)
+        out.emplace_back(keys.back());
+
+    // constant track
+    if (out.size() == 2 && std::equal(out[0].value, out[0].value + 3, out[1].value)) {
+        out.pop_back();
+    }
+
+    out.shrink_to_fit();
+}
+
+inline float rotationDistance(const quat &lhs, const quat &rhs) {
+    return 2.0f * std::acos(std::clamp(std::abs(dot(lhs, rhs)), 0.0f, 1.0f));
+}
+
+template<typename T>
+inline void freeKeys(vector<T> &keys) {
+    vector<T>().swap(keys);
+}
+
+AnimationCompressor::Info AnimationCompressor::compress(Animation &animation) const {
+    Info info;
+
+    if (animation.isCompressed())
+        return info;
+
+    // compute frame step and quantization ranges
+
+    float maxTime = static_cast<float>(animation.duration);
+    float minDelta = FLT_MAX;
+
+    vec3 positionMin(FLT_MAX), positionMax(-FLT_MAX);
+    vec3 scalingMin(FLT_MAX), scalingMax(-FLT_MAX);
+
+    auto scanTimes = [&](const auto &keys) {
+        for (usize i = 0; i < keys.size(); i++) {
+            maxTime = std::max(maxTime, keys[i].getTime());
+
+            if (i > 0) {
+                float delta = keys[i].getTime() - keys[i - 1].getTime();
+
+                if (delta > 0.0f) {
+                    minDelta = std::min(minDelta, delta);
+                }
+            }
+        }
+    };
+
+    for (const auto &channel : animation.channels) {
+        scanTimes(channel.positionKeys);
+        scanTimes(channel.scalingKeys);
+        scanTimes(channel.rotationKeys);
+
+        for (const auto &key : channel.positionKeys) {
+            positionMin = glm::min(positionMin, key.value);
+            positionMax = glm::max(positionMax, key.value);
+        }
+
+        for (const auto &key : channel.scalingKeys) {
+            scalingMin = glm::min(scalingMin, key.value);
+            scalingMax = glm::max(scalingMax, key.value);
+        }
+    }
+
+    if (animation.channels.empty())
+        return info;
+
+    float frameStep = minDelta != FLT_MAX ? minDelta : 1.0f;
+    frameStep = std::max(frameStep, maxTime / maxFrame);
+
+    CompressedAnimNode::Range positionRange;
+    positionRange.min = positionMin;
+    positionRange.extent = glm::max(positionMax - positionMin, vec3(0.0f));
+
+    CompressedAnimNode::Range scalingRange;
+    scalingRange.min = scalingMin;
+    scalingRange.extent = glm::max(scalingMax - scalingMin, vec3(0.0f));
+
+    // compress keys
+
+    auto vecDistance = [](const vec3 &lhs, const vec3 &rhs) { return length(lhs - rhs); };
+    auto vecInterpolate = [](const vec3 &start, const vec3 &end, float factor) { return mix(start, end, factor); };
+
+    auto rotationInterpolate = [](const quat &start, const quat &end, float factor) {
+        return normalize(slerp(start, end, factor));
+    };
+
+    for (auto &channel : animation.channels) {
+        auto &compressed = channel.compressed;
+
+        reduceKeys(channel.positionKeys, frameStep, m_positionTolerance, compressed.positionKeys,
+                   [&](const vec3 &v, uint16 *out) { positionRange.encode(v, out); },
+                   [&](const uint16 *v) { return positionRange.decode(v); },
+                   vecInterpolate, vecDistance);
+
+        reduceKeys(channel.scalingKeys, frameStep, m_scalingTolerance, compressed.scalingKeys,
+                   [&](const vec3 &v, uint16 *out) { scalingRange.encode(v, out); },
+                   [&](const uint16 *v) { return scalingRange.decode(v); },
+                   vecInterpolate, vecDistance);
+
+        reduceKeys(channel.rotationKeys, frameStep, m_rotationTolerance, compressed.rotationKeys,
+                   &CompressedAnimNode::encodeRotation, &CompressedAnimNode::decodeRotation,
+                   rotationInterpolate, rotationDistance);
+
+        info.originalSize += channel.positionKeys.size() * sizeof(VecAnimKey) +
+                channel.scalingKeys.size() * sizeof(VecAnimKey) +
+                channel.rotationKeys.size() * sizeof(QuatAnimKey);
+        info.compressedSize += compressed.getSizeInBytes();
+    }
+
+    // measure error on the source keys
+
+    for (const auto &channel : animation.channels) {
+        const auto &compressed = channel.compressed;
+
+        for (const auto &key : channel.positionKeys) {
+            vec3 value = compressed.samplePosition(key.getTime() / frameStep, positionRange);
+            info.maxPositionError = std::max(info.maxPositionError, vecDistance(value, key.value));
+        }
+
+        for (const auto &key : channel.scalingKeys) {
+            vec3 value = compressed.sampleScaling(key.getTime() / frameStep, scalingRange);
+            info.maxScalingError = std::max(info.maxScalingError, vecDistance(value, key.value));
+        }
+
+        for (const auto &key : channel.rotationKeys) {
+            quat value = compressed.sampleRotation(key.getTime() / frameStep);
+            info.maxRotationError = std::max(info.maxRotationError, rotationDistance(value, normalize(key.value)));
+        }
+    }
+
+    // replace source keys
+
+    for (auto &channel : animation.channels) {
+        freeKeys(channel.positionKeys);
+        freeKeys(channel.scalingKeys);
+        freeKeys(channel.rotationKeys);
+    }
+
+    animation.frameStep = frameStep;
+    animation.positionRange = positionRange;
+    animation.scalingRange = scalingRange;
+
+    if (info.compressedSize != 0)
+        info.ratio = static_cast<float>(info.originalSize) / static_cast<float>(info.compressedSize);
+
+    return info;
+}
+
+void AnimationCompressor::setPositionTolerance(float tolerance) {
+    m_positionTolerance = tolerance;
+}
+
+void AnimationCompressor::setRotationTolerance(float tolerance) {
+    m_rotationTolerance = tolerance;
+}
+
+void AnimationCompressor::setScalingTolerance(float tolerance) {
+    m_scalingTolerance = tolerance;
+}
+
+float AnimationCompressor::getPositionTolerance() const {
+    return m_positionTolerance;
+}
+
+float AnimationCompressor::getRotationTolerance() const {
+    return m_rotationTolerance;
+}
+
+float AnimationCompressor::getScalingTolerance() const {
+    return m_scalingTolerance;
+}
+}
@@ -0,0 +1,192 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/AnimationLodManager.h>
+
+#include <algine/std/animation/Animator.h>
+#include <algine/std/model/Model.h>
+#include <algine/std/model/Shape.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+AnimationLodManager::AnimationLodManager() {
+    m_levels.emplace_back();
+}
+
+void AnimationLodManager::addModel(const ModelPtr &model, float boundingRadius) {
+    if (model->getAnimator() == nullptr)
+        throw invalid_argument("Model has no animator");
+
+    auto &entry = m_entries.emplace_back();
+    entry.model = model;
+    entry.boundingRadius = boundingRadius;
+    entry.phase = m_nextPhase++;
+}
+
+void AnimationLodManager::removeModel(const ModelPtr &model) {
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry &entry) {
+        return entry.model == model;
+    });
+
+    if (it != m_entries.end()) {
+        model->setBones(nullptr);
+        m_entries.erase(it);
+    }
+}
+
+void AnimationLodManager::update(const mat4 &view, const mat4 &projection, float timeInSeconds) {
+    m_frame++;
+    m_evaluatedBones = 0;
+    m_due.clear();
+
+    // classify models
+
+    for (auto &entry : m_entries) {
+        vec4 viewPos = view * vec4(entry.model->getPos(), 1.0f);
+        float depth = std::max(-viewPos.z, 1e-4f);
+
+        entry.screenSize = entry.boundingRadius * projection[1][1] / depth;
+        entry.level = m_levels.size() - 1;
+
+        for (Index i = 0; i < m_levels.size(); i++) {
+            if (entry.screenSize >= m_levels[i].minScreenSize) {
+                entry.level = i;
+                break;
+            }
+        }
+
+        entry.framesSinceUpdate++;
+
+        uint interval = std::max(m_levels[entry.level].updateInterval, 1u);
+
+        if (!entry.initialized || entry.framesSinceUpdate >= interval || (m_frame + entry.phase) % interval == 0) {
+            m_due.emplace_back(&entry);
+        }
+    }
+
+    // animate due models, the most visible first
+
+    std::sort(m_due.begin(), m_due.end(), [](const Entry *lhs, const Entry *rhs) {
+        return lhs->screenSize * static_cast<float>(lhs->framesSinceUpdate + 1) >
+               rhs->screenSize * static_cast<float>(rhs->framesSinceUpdate + 1);
+    });
+
+    for (auto entry : m_due) {
+        uint bonesCount = entry->model->getShape()->getBonesAmount();
+
+        // at least one model per frame is always animated
+        bool isOverBudget = m_boneBudget != 0 && m_evaluatedBones != 0 && m_evaluatedBones + bonesCount > m_boneBudget;
+
+        if (isOverBudget && entry->initialized)
+            continue;
+
+        animate(*entry, timeInSeconds);
+
+        m_evaluatedBones += bonesCount;
+    }
+
+    // interpolate bones of the models with reduced update rate
+
+    for (auto &entry : m_entries) {
+        uint interval = std::max(m_levels[entry.level].updateInterval, 1u);
+
+        if (interval == 1) {
+            // setBones marks bones as changed, so it's called only on update
+            if (entry.framesSinceUpdate == 0 || entry.model->getBones() != &entry.current)
+                entry.model->setBones(&entry.current);
+
+            continue;
+        }
+
+        // bones stay the same until the next update
+        if (entry.framesSinceUpdate > interval)
+            continue;
+
+        float factor = std::min(static_cast<float>(entry.framesSinceUpdate) / static_cast<float>(interval), 1.0f);
+
+        entry.bones.resize(entry.current.size());
+
+        for (Index i = 0; i < entry.bones.size(); i++) {
+            entry.bones[i] = entry.previous[i] + (entry.current[i] - entry.previous[i]) * factor;
+        }
+
+        entry.model->setBones(&entry.bones);
+    }
+}
+
+void AnimationLodManager::animate(Entry &entry, float timeInSeconds) {
+    const auto &model = entry.model;
+    auto shape = model->getShape().get();
+
+    const BoneMask *frozenJoints = m_levels[entry.level].freezeLeafJoints ? &getLeafJoints(shape) : nullptr;
+
+    Animator::samplePose(*shape, model->getAnimator()->getAnimationIndex(), timeInSeconds, entry.pose, frozenJoints);
+
+    std::swap(entry.previous, entry.current);
+    entry.current.resize(shape->getBonesAmount());
+
+    Animator::computeBones(*shape, entry.pose, model->getBoneTransformations(), entry.globals, entry.current);
+
+    if (!entry.initialized) {
+        entry.previous = entry.current;
+        entry.initialized = true;
+    }
+
+    entry.framesSinceUpdate = 0;
+}
+
+void AnimationLodManager::setLevels(const vector<Level> &levels) {
+    if (levels.empty())
+        throw invalid_argument("At least one level must be specified");
+
+    m_levels = levels;
+
+    for (auto &entry : m_entries) {
+        entry.level = 0;
+    }
+}
+
+void AnimationLodManager::setBoneBudget(uint budget) {
+    m_boneBudget = budget;
+}
+
+const vector<AnimationLodManager::Level>& AnimationLodManager::getLevels() const {
+    return m_levels;
+}
+
+uint AnimationLodManager::getBoneBudget() const {
+    return m_boneBudget;
+}
+
+Index AnimationLodManager::getLevel(const ModelPtr &model) const {
+    return getEntry(model).level;
+}
+
+float AnimationLodManager::getScreenSize(const ModelPtr &model) const {
+    return getEntry(model).screenSize;
+}
+
+uint AnimationLodManager::getEvaluatedBones() const {
+    return m_evaluatedBones;
+}
+
+const AnimationLodManager::Entry& AnimationLodManager::getEntry(const ModelPtr &model) const {
+    for (const auto &entry : m_entries) {
+        if (entry.model == model) {
+            return entry;
+        }
+    }
+
+    throw invalid_argument("Model has not been added");
+}
+
+const BoneMask& AnimationLodManager::getLeafJoints(Shape *shape) {
+    if (auto it = m_leafJoints.find(shape); it != m_leafJoints.end())
+        return it->second;
+
+    return m_leafJoints[shape] = shape->getSkeleton().getLeafJoints();
+}
+}
@@ -7,11 +7,23 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include <stdexcept>
+#include <algorithm>
 
 using namespace std;
 using namespace glm;
 
 namespace algine {
+uint Animator::m_skippedEvaluations = 0;
+
+inline float getAnimationTime(const Animation &animation, float timeInSeconds) {
+    auto animTicksPerSecond = static_cast<float>(animation.ticksPerSecond);
+    float ticksPerSecond = animTicksPerSecond != 0 ? animTicksPerSecond : 25.0f;
+
+    float timeInTicks = timeInSeconds * ticksPerSecond;
+
+    return fmodf(timeInTicks, static_cast<float>(animation.duration));
+}
+
 Animator::Animator() = default;
 
 Animator::Animator(Model *model, const string &animationName)
@@ -25,22 +37,50 @@ Animator::Animator(Model *model, Index animationIndex)
       m_animationIndex(animationIndex) {}
 
 void Animator::animate(float timeInSeconds) {
-    mat4 identity;
-
     const auto &shape = m_model->getShape();
     const auto &animation = shape->getAnimation(m_animationIndex);
 
-    auto animTicksPerSecond = static_cast<float>(animation.ticksPerSecond);
-    float ticksPerSecond = animTicksPerSecond != 0 ? animTicksPerSecond : 25.0f;
+    float animationTime = getAnimationTime(animation, timeInSeconds);
+    uint transformationsVersion = m_model->getBoneTransformationsVersion();
+    auto &bones = m_model->animationBones(m_animationIndex);
+    uint bonesGeneration = m_model->m_posePool->getGeneration(m_model->m_animSlots[m_animationIndex]);
+
+    // slot is acquired on the first sampling
+    if (m_model->getBones() == nullptr)
+        m_model->setBones(&bones);
+
+    // nothing has changed since the last evaluation
+    if (animationTime == m_lastAnimationTime && m_animationIndex == m_lastAnimationIndex &&
+        transformationsVersion == m_lastTransformationsVersion && bones.data() == m_lastBones &&
+        bonesGeneration == m_lastBonesGeneration)
+    {
+        m_skippedEvaluations++;
+        return;
+    }
 
-    float timeInTicks = timeInSeconds * ticksPerSecond;
-    float animationTime = fmodf(timeInTicks, static_cast<float>(animation.duration));
+    samplePose(*shape, m_animationIndex, timeInSeconds, m_pose);
+    computeBones(*shape, m_pose, m_model->m_boneTransformations, m_globals, bones);
+
+    if (!animation.morphChannels.empty()) {
+        sampleMorphWeights(*shape, m_animationIndex, timeInSeconds, m_model->m_morphWeights);
+    }
+
+    m_model->invalidateBones();
 
-    readNodeHierarchy(animationTime, shape->getRootNode(), identity);
+    m_lastAnimationTime = animationTime;
+    m_lastAnimationIndex = m_animationIndex;
+    m_lastTransformationsVersion = transformationsVersion;
+    m_lastBones = bones.data();
+    m_lastBonesGeneration = bonesGeneration;
+}
+
+void Animator::samplePose(float timeInSeconds, LocalPose &out) const {
+    samplePose(*m_model->getShape(), m_animationIndex, timeInSeconds, out);
 }
 
 void Animator::setModel(Model *model) {
     m_model = model;
+    m_lastBones = nullptr;
 }
 
 void Animator::setAnimationIndex(Index animationIndex) {
@@ -70,6 +110,14 @@ Index Animator::getAnimationIndex() const {
     return m_animationIndex;
 }
 
+uint Animator::getSkippedEvaluations() {
+    return m_skippedEvaluations;
+}
+
+void Animator::resetSkippedEvaluations() {
+    m_skippedEvaluations = 0;
+}
+
 inline usize findPosition(float animationTime, const AnimNode *animNode) {
     assert(!animNode->positionKeys.empty());
 
@@ -182,62 +230,116 @@ inline void calcInterpolatedScaling(vec3 &out, float animationTime, const AnimNo
     out = start + factor * delta;
 }
 
-inline const AnimNode* findNodeAnim(const Animation *animation, const string &nodeName) {
-    for (usize i = 0 ; i < animation->channels.size(); i++) {
-        const AnimNode *channel = &animation->channels[i];
+inline void sampleJoint(const Animation &animation, const AnimNode &animNode, float animationTime, JointTransform &out) {
+    if (animation.isCompressed()) {
+        float frame = animationTime / animation.frameStep;
+        const auto &compressed = animNode.compressed;
+
+        out.translation = compressed.samplePosition(frame, animation.positionRange);
+        out.rotation = compressed.sampleRotation(frame);
+        out.scale = compressed.sampleScaling(frame, animation.scalingRange);
+    } else {
+        calcInterpolatedPosition(out.translation, animationTime, &animNode);
+        calcInterpolatedRotation(out.rotation, animationTime, &animNode);
+        calcInterpolatedScaling(out.scale, animationTime, &animNode);
+    }
+}
+
+void Animator::samplePose(const Shape &shape, Index animationIndex, float timeInSeconds, LocalPose &out,
+                          const BoneMask *frozenJoints)
+{
+    const auto &skeleton = shape.getSkeleton();
+    const auto &joints = skeleton.getJoints();
+    const auto &channels = skeleton.getChannels(animationIndex);
+    const auto &animation = shape.getAnimation(animationIndex);
 
-        if (channel->name == nodeName) {
-            return channel;
-        }
+    float animationTime = getAnimationTime(animation, timeInSeconds);
+
+    // frozen joints can keep their values only if the pose was sampled before
+    if (out.size() != joints.size()) {
+        out.resize(joints.size());
+        frozenJoints = nullptr;
     }
 
-    return nullptr;
+    for (Index i = 0; i < joints.size(); i++) {
+        if (frozenJoints && frozenJoints->test(i))
+            continue;
+
+        if (Index channel = channels[i]; channel != Skeleton::None) {
+            sampleJoint(animation, animation.channels[channel], animationTime, out[i]);
+        } else {
+            out[i] = joints[i].defaultTransform;
+        }
+    }
 }
 
-void Animator::readNodeHierarchy(float animationTime, const Node &node, const mat4 &parentTransform) {
-    const auto &shape = m_model->getShape();
+void Animator::computeBones(const Shape &shape, const LocalPose &pose, const BoneMatrices &boneTransformations,
+                            vector<mat4> &globals, BoneMatrices &out)
+{
+    const auto &joints = shape.getSkeleton().getJoints();
+    const auto &bones = shape.getBones();
 
-    const string &nodeName = node.name;
-    const Animation &animation = shape->getAnimation(m_animationIndex);
-    const AnimNode *animNode = findNodeAnim(&animation, nodeName);
-    mat4 nodeTransformation = node.defaultTransform;
+    globals.resize(joints.size());
 
-    if (animNode) {
-        // Интерполируем масштабирование и генерируем матрицу преобразования масштаба
-        vec3 scaling;
-        calcInterpolatedScaling(scaling, animationTime, animNode);
+    // parents precede their children, so their global transformations are ready
+    for (Index i = 0; i < joints.size(); i++) {
+        const auto &joint = joints[i];
+        auto &globalTransformation = globals[i];
 
-        mat4 scalingM = scale(mat4(1.0), scaling);
+        if (joint.parent == Skeleton::None) {
+            globalTransformation = pose[i].toMat4();
+        } else {
+            globalTransformation = globals[joint.parent] * pose[i].toMat4();
+        }
 
-        // Интерполируем вращение и генерируем матрицу вращения
-        quat rotationQ;
-        calcInterpolatedRotation(rotationQ, animationTime, animNode);
+        if (joint.bone != Skeleton::None) {
+            globalTransformation *= boneTransformations[joint.bone];
+            out[joint.bone] = shape.getGlobalInverseTransform() * globalTransformation * bones[joint.bone].boneMatrix;
+        }
+    }
+}
 
-        mat4 rotationM = toMat4(rotationQ);
+void Animator::sampleMorphWeights(const Shape &shape, Index animationIndex, float timeInSeconds, vector<float> &out) {
+    const auto &animation = shape.getAnimation(animationIndex);
+    const auto &morphTargets = shape.getMorphTargets();
 
-        //  Интерполируем смещение и генерируем матрицу смещения
-        vec3 translation;
-        calcInterpolatedPosition(translation, animationTime, animNode);
+    out.assign(morphTargets.getTargetsCount(), 0.0f);
 
-        mat4 translationM = translate(mat4(1.0), translation);
+    float animationTime = getAnimationTime(animation, timeInSeconds);
 
-        // Объединяем преобразования
-        nodeTransformation = translationM * rotationM * scalingM;
-    }
+    auto addWeights = [&](const MorphAnimNode &channel, const MorphAnimNode::Key &key, float factor) {
+        for (const auto &meshName : channel.meshNames) {
+            for (usize i = 0; i < key.targets.size(); i++) {
+                Index target = morphTargets.getTargetIndex(meshName, key.targets[i]);
 
-    mat4 globalTransformation = parentTransform * nodeTransformation;
+                if (target != MorphTargets::TargetNotFound) {
+                    out[target] += key.weights[i] * factor;
+                }
+            }
+        }
+    };
 
-    if (uint index = shape->m_bones.getIndex(nodeName); index != BonesStorage::BoneNotFound) {
-        auto &bone = shape->m_bones[index];
-        auto &boneTransformation = m_model->m_boneTransformations[index];
-        auto &dstBone = m_model->m_animBones[m_animationIndex][index];
+    for (const auto &channel : animation.morphChannels) {
+        const auto &keys = channel.keys;
 
-        globalTransformation *= boneTransformation;
-        dstBone = shape->getGlobalInverseTransform() * globalTransformation * bone.boneMatrix;
-    }
+        if (keys.empty())
+            continue;
+
+        // first key after the animation time
+        auto next = std::upper_bound(keys.begin(), keys.end(), animationTime,
+                                     [](float time, const MorphAnimNode::Key &key) { return time < key.time; });
 
-    for (const auto &child : node.childs) {
-        readNodeHierarchy(animationTime, child, globalTransformation);
+        if (next == keys.begin()) {
+            addWeights(channel, *next, 1.0f);
+        } else if (next == keys.end()) {
+            addWeights(channel, keys.back(), 1.0f);
+        } else {
+            auto prev = next - 1;
+            auto factor = static_cast<float>((animationTime - prev->time) / (next->time - prev->time));
+
+            addWeights(channel, *prev, 1.0f - factor);
+            addWeights(channel, *next, factor);
+        }
     }
 }
 }
@@ -0,0 +1,155 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/BakedAnimation.h>
+
+#include <algine/std/animation/Animator.h>
+#include <algine/std/model/Model.h>
+#include <algine/std/model/Shape.h>
+
+#include <algine/core/texture/Texture2D.h>
+#include <algine/core/PtrMaker.h>
+
+#include <algine/constants/BoneSystem.h>
+
+#include <stdexcept>
+#include <cmath>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+BakedAnimation::BakedAnimation() = default;
+
+BakedAnimation::BakedAnimation(const ShapePtr &shape, Index animationIndex, float sampleRate) {
+    bake(shape, animationIndex, sampleRate);
+}
+
+void BakedAnimation::bake(const ShapePtr &shape, Index animationIndex, float sampleRate) {
+    if (!shape->isAnimationsPresent())
+        throw runtime_error("Shape has no animations");
+
+    if (sampleRate <= 0.0f)
+        throw invalid_argument("Sample rate must be positive");
+
+    const auto &animation = shape->getAnimation(animationIndex);
+
+    auto animTicksPerSecond = static_cast<float>(animation.ticksPerSecond);
+    float ticksPerSecond = animTicksPerSecond != 0 ? animTicksPerSecond : 25.0f;
+
+    m_animationIndex = animationIndex;
+    m_duration = static_cast<float>(animation.duration) / ticksPerSecond;
+    m_bonesCount = shape->getBonesAmount();
+
+    // frames are spread evenly over the loop, so the actual rate can differ slightly
+    m_framesCount = std::max(1u, static_cast<uint>(std::round(m_duration * sampleRate)));
+    m_sampleRate = m_duration > 0.0f ? static_cast<float>(m_framesCount) / m_duration : sampleRate;
+
+    Model model;
+    model.setShape(shape);
+    model.activateAnimation(animationIndex);
+    model.setBonesFromAnimation(animationIndex);
+
+    Animator animator(&model, animationIndex);
+
+    m_frames.resize(m_framesCount * m_bonesCount);
+
+    for (uint frame = 0; frame < m_framesCount; frame++) {
+        animator.animate(static_cast<float>(frame) / m_sampleRate);
+
+        const auto &bones = *model.getBones();
+        std::copy(bones.begin(), bones.end(), m_frames.begin() + frame * m_bonesCount);
+    }
+}
+
+void BakedAnimation::createTexture() {
+    if (m_texture == nullptr)
+        m_texture = PtrMaker::make();
+
+    m_texture->bind();
+    m_texture->setFormat(Texture::RGBA32F);
+    m_texture->setDimensions(m_bonesCount * 4, m_framesCount);
+    m_texture->update(Texture::RGBA, static_cast<uint>(DataType::Float), m_frames.data());
+    m_texture->setParams(map<uint, uint> {
+        {Texture::MinFilter, Texture::Nearest},
+        {Texture::MagFilter, Texture::Nearest},
+        {Texture::WrapU, Texture::ClampToEdge},
+        {Texture::WrapV, Texture::ClampToEdge}
+    });
+    m_texture->unbind();
+}
+
+BakedAnimation::Pose BakedAnimation::getPose(float timeInSeconds, float phaseOffset) const {
+    Pose pose;
+
+    if (m_duration <= 0.0f)
+        return pose;
+
+    float time = fmodf(timeInSeconds + phaseOffset, m_duration);
+
+    if (time < 0.0f)
+        time += m_duration;
+
+    float position = time * m_sampleRate;
+
+    pose.frame = std::min(static_cast<uint>(position), m_framesCount - 1);
+    pose.nextFrame = (pose.frame + 1) % m_framesCount;
+    pose.factor = position - static_cast<float>(pose.frame);
+
+    return pose;
+}
+
+void BakedAnimation::sample(const Pose &pose, BoneMatrices &out) const {
+    out.resize(m_bonesCount);
+
+    const BoneMatrix *frame = getFrame(pose.frame);
+    const BoneMatrix *nextFrame = getFrame(pose.nextFrame);
+
+    for (uint i = 0; i < m_bonesCount; i++) {
+        out[i] = frame[i] + (nextFrame[i] - frame[i]) * pose.factor;
+    }
+}
+
+void BakedAnimation::sample(float timeInSeconds, float phaseOffset, BoneMatrices &out) const {
+    sample(getPose(timeInSeconds, phaseOffset), out);
+}
+
+void BakedAnimation::setUniforms(ShaderProgram *program, const Pose &pose, uint textureSlot) const {
+    using namespace Module::BoneSystem::Vars;
+
+    m_texture->use(textureSlot);
+
+    program->setInt(BakedBones, static_cast<int>(textureSlot));
+    program->setVec3(BakedPose, vec3(pose.frame, pose.nextFrame, pose.factor));
+}
+
+const BoneMatrix* BakedAnimation::getFrame(Index frame) const {
+    return &m_frames[frame * m_bonesCount];
+}
+
+const BoneMatrices& BakedAnimation::getFrames() const {
+    return m_frames;
+}
+
+const Texture2DPtr& BakedAnimation::getTexture() const {
+    return m_texture;
+}
+
+Index BakedAnimation::getAnimationIndex() const {
+    return m_animationIndex;
+}
+
+uint BakedAnimation::getFramesCount() const {
+    return m_framesCount;
+}
+
+uint BakedAnimation::getBonesCount() const {
+    return m_bonesCount;
+}
+
+float BakedAnimation::getSampleRate() const {
+    return m_sampleRate;
+}
+
+float BakedAnimation::getDuration() const {
+    return m_duration;
+}
+}
@@ -0,0 +1,90 @@
+#include <algine/std/animation/BoneMask.h>
+
+#include <algine/std/animation/Skeleton.h>
+
+#include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+namespace algine {
+constexpr uint wordBits = 64;
+
+inline uint64_t fullWord(bool value) {
+    return value ? ~static_cast<uint64_t>(0) : 0;
+}
+
+BoneMask::BoneMask() = default;
+
+BoneMask::BoneMask(uint size, bool value) {
+    resize(size, value);
+}
+
+void BoneMask::resize(uint size, bool value) {
+    // fill padding bits of the last word, they become the new bits
+    if (uint used = m_size % wordBits; used != 0) {
+        uint64_t usedBits = (static_cast<uint64_t>(1) << used) - 1;
+        m_words.back() = value ? (m_words.back() | ~usedBits) : (m_words.back() & usedBits);
+    }
+
+    m_words.resize((size + wordBits - 1) / wordBits, fullWord(value));
+    m_size = size;
+}
+
+void BoneMask::set(Index index, bool value) {
+    uint64_t bit = static_cast<uint64_t>(1) << (index % wordBits);
+
+    if (value) {
+        m_words[index / wordBits] |= bit;
+    } else {
+        m_words[index / wordBits] &= ~bit;
+    }
+}
+
+void BoneMask::setAll(bool value) {
+    std::fill(m_words.begin(), m_words.end(), fullWord(value));
+}
+
+void BoneMask::invert() {
+    for (auto &word : m_words) {
+        word = ~word;
+    }
+}
+
+bool BoneMask::test(Index index) const {
+    return (m_words[index / wordBits] >> (index % wordBits)) & 1u;
+}
+
+uint BoneMask::size() const {
+    return m_size;
+}
+
+bool BoneMask::empty() const {
+    return m_size == 0;
+}
+
+BoneMask BoneMask::fromJoints(const Skeleton &skeleton, const vector<string> &names, bool includeChildren) {
+    BoneMask mask(skeleton.getJointsCount());
+
+    for (const auto &name : names) {
+        Index index = skeleton.getJointIndex(name);
+
+        if (index == Skeleton::None)
+            throw invalid_argument("Joint '" + name + "' not found");
+
+        mask.set(index);
+    }
+
+    // parents precede their children, so one pass spreads the bits down the hierarchy
+    if (includeChildren) {
+        for (Index i = 0; i < skeleton.getJointsCount(); i++) {
+            if (Index parent = skeleton.getJoint(i).parent; parent != Skeleton::None && mask.test(parent)) {
+                mask.set(i);
+            }
+        }
+    }
+
+    return mask;
+}
+}
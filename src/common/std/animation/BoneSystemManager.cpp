@@ -5,7 +5,15 @@
 
 #include <algine/constants/BoneSystem.h>
 
+#include <algine/core/shader/ShaderProgram.h>
+
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <tulz/macros.h>
+
+#include <stdexcept>
+#include <cstring>
 
 using namespace std;
 using namespace glm;
@@ -13,11 +21,34 @@ using namespace glm;
 namespace algine {
 constexpr uint empty_block = 0;
 
+BoneSystemManager::~BoneSystemManager() {
+    deletePtr(m_paletteTexture)
+    deletePtr(m_paletteBuffer)
+}
+
 void BoneSystemManager::init() {
+    if (m_mode == Mode::Palette) {
+        m_paletteBuffer = new ArrayBuffer();
+        m_paletteTexture = new TextureBuffer();
+
+        for (const auto &program : m_programs) {
+            program->bind();
+            program->setInt(Module::BoneSystem::Vars::BonePalette, static_cast<int>(m_paletteSlot));
+            program->unbind();
+        }
+
+        return;
+    }
+
     using namespace Module::BoneSystem::Vars::Block;
 
     m_uniformBlock.setName(Name);
-    m_uniformBlock.setVarNames({Bones, BoneAttribsPerVertex});
+
+    if (m_boneFormat == BoneFormat::ScaledDualQuaternion) {
+        m_uniformBlock.setVarNames({Bones, BoneScales, BoneAttribsPerVertex});
+    } else {
+        m_uniformBlock.setVarNames({Bones, BoneAttribsPerVertex});
+    }
 
     for (const auto &program : m_programs)
         m_uniformBlock.assignBindingPoint(program.get());
@@ -25,12 +56,24 @@ void BoneSystemManager::init() {
     m_uniformBlock.init(m_programs[0].get());
 
     m_bonesPos = m_uniformBlock.getVarPosition(Bones);
+
+    if (m_boneFormat == BoneFormat::ScaledDualQuaternion)
+        m_boneScalesPos = m_uniformBlock.getVarPosition(BoneScales);
     m_boneAttribsCountPos = m_uniformBlock.getVarPosition(BoneAttribsPerVertex);
 
     m_bufferStorage.setBufferType(Buffer::Uniform);
     m_bufferStorage.setBufferUsage(Buffer::DynamicDraw);
     m_bufferStorage.setBlockSize(m_uniformBlock.getSize(), UniformBuffer::getOffsetAlignment());
     m_bufferStorage.allocateStorage();
+    m_bufferStorage.setRemapCallback([this](uint oldIndex, uint newIndex) {
+        for (auto *ids : {&m_ids, &m_sharedIds}) {
+            for (auto &p : *ids) {
+                if (p.second == oldIndex) {
+                    p.second = newIndex;
+                }
+            }
+        }
+    });
 
     int zero = 0;
 
@@ -42,33 +85,160 @@ void BoneSystemManager::init() {
 }
 
 void BoneSystemManager::writeBonesForAll() {
+    m_writtenBones.clear();
+    m_sharedIds.clear();
+
     for (const auto &p : m_ids) {
-        writeBones(p.first, p.second);
+        const auto &model = p.first;
+
+        // bones are not set until an animation is sampled
+        if (!model->getShape()->isBonesPresent() || model->getBones() == nullptr)
+            continue;
+
+        // models with the same bones (e.g. from SharedPoseCache) use one block / palette range
+        if (auto it = m_writtenBones.find(model->getBones()); it != m_writtenBones.end()) {
+            if (const auto &writer = it->second; writer->getShape() == model->getShape()) {
+                m_sharedIds[model] = m_ids[writer];
+                m_writtenVersions.erase(model); // own block must be rewritten when sharing ends
+                continue;
+            }
+        }
+
+        m_writtenBones[model->getBones()] = model;
+
+        if (!isBonesChanged(model)) {
+            m_skippedUploads++;
+            continue;
+        }
+
+        if (m_mode == Mode::Palette) {
+            writePaletteBones(model, p.second);
+            m_paletteChanged = true;
+        } else {
+            writeBones(model, p.second);
+        }
+    }
+
+    if (m_mode == Mode::Palette && (m_paletteChanged || m_paletteResized)) {
+        uploadPalette();
+        m_paletteChanged = false;
     }
 }
 
 void BoneSystemManager::writeBones(const ModelPtr &model) {
-    if (model->getShape()->isBonesPresent()) {
+    if (!model->getShape()->isBonesPresent() || model->getBones() == nullptr)
+        return;
+
+    m_sharedIds.erase(model);
+
+    if (!isBonesChanged(model)) {
+        m_skippedUploads++;
+        return;
+    }
+
+    if (m_mode == Mode::Palette) {
+        Index offset = m_ids[model];
+        writePaletteBones(model, offset);
+
+        if (m_paletteResized) {
+            uploadPalette();
+        } else {
+            uint texels = getTexelsPerBone();
+            uint size = sizeof(vec4) * texels * model->getShape()->getBonesAmount();
+
+            m_paletteBuffer->bind();
+            m_paletteBuffer->updateData(sizeof(vec4) * texels * offset, size, value_ptr(m_palette[offset * texels]));
+            m_paletteBuffer->unbind();
+        }
+    } else {
         writeBones(model, m_ids[model]);
     }
 }
 
 void BoneSystemManager::linkBuffer(const ModelPtr &model) {
+    linkBuffer(model, nullptr);
+}
+
+void BoneSystemManager::linkBuffer(const ModelPtr &model, ShaderProgram *program) {
+    if (m_mode == Mode::Palette) {
+        using namespace Module::BoneSystem::Vars;
+
+        if (program == nullptr)
+            throw runtime_error("Palette mode requires shader program to link bones");
+
+        if (model->getShape()->isBonesPresent()) {
+            int attribsCount = getAttribsCount(model->getShape()->getBonesPerVertex());
+            program->setInt(BoneBaseOffset, static_cast<int>(getLinkedId(model)));
+            program->setInt(BoneAttribsPerVertex, attribsCount);
+        } else {
+            program->setInt(BoneAttribsPerVertex, 0);
+        }
+
+        return;
+    }
+
     if (model->getShape()->isBonesPresent()) {
-        linkUniformBuffer(m_ids[model]);
+        linkUniformBuffer(getLinkedId(model));
     } else {
         linkUniformBuffer(empty_block);
     }
 }
 
 void BoneSystemManager::setupBones(const ModelPtr &model) {
+    setupBones(model, nullptr);
+}
+
+void BoneSystemManager::setupBones(const ModelPtr &model, ShaderProgram *program) {
+    writeBones(model);
+    linkBuffer(model, program);
+}
+
+void BoneSystemManager::setupBones(const ModelPtr &model, StreamBuffer &stream) {
+    if (m_mode == Mode::Palette)
+        throw runtime_error("Stream buffer can be used only in the UniformBlock mode");
+
+    auto range = stream.allocate(m_uniformBlock.getSize());
+
+    int attribsCount = 0;
+
     if (model->getShape()->isBonesPresent()) {
-        uint index = m_ids[model];
-        writeBones(model, index);
-        linkUniformBuffer(index);
-    } else {
-        linkUniformBuffer(empty_block);
+        attribsCount = getAttribsCount(model->getShape()->getBonesPerVertex());
+
+        writeBones(model, [&](uint position, uint size, const void *data) {
+            m_uniformBlock.write(range, position, size, data);
+        });
     }
+
+    m_uniformBlock.write(range, m_boneAttribsCountPos, sizeof(int), &attribsCount);
+
+    stream.commit(range);
+    stream.bindRange(m_uniformBlock.getBindingPoint(), range);
+
+    m_linkedBlock = -1;
+}
+
+void BoneSystemManager::compactStorage() {
+    if (m_mode == Mode::Palette)
+        return;
+
+    m_bufferStorage.compact();
+    m_linkedBlock = -1;
+}
+
+void BoneSystemManager::bindPalette() const {
+    m_paletteTexture->use(m_paletteSlot);
+}
+
+void BoneSystemManager::setMode(Mode mode) {
+    m_mode = mode;
+}
+
+void BoneSystemManager::setBoneFormat(BoneFormat format) {
+    m_boneFormat = format;
+}
+
+void BoneSystemManager::setPaletteSlot(uint slot) {
+    m_paletteSlot = slot;
 }
 
 void BoneSystemManager::setMaxModelsCount(uint count) {
@@ -88,9 +258,19 @@ void BoneSystemManager::addShaderProgram(const ShaderProgramPtr &shaderProgram)
 }
 
 void BoneSystemManager::addModel(const ModelPtr &model) {
+    if (m_mode == Mode::Palette) {
+        m_ids[model] = allocatePaletteRange(model->getShape()->getBonesAmount());
+        return;
+    }
+
+    uint capacity = m_bufferStorage.capacity();
     uint index = m_bufferStorage.allocateBlock();
     m_ids[model] = index;
 
+    // storage has grown, buffer id has changed
+    if (m_bufferStorage.capacity() != capacity)
+        m_linkedBlock = -1;
+
     int attribsCount = getAttribsCount(model->getShape()->getBonesPerVertex());
     m_bufferStorage.write(index, m_uniformBlock.getVarOffset(m_boneAttribsCountPos), sizeof(int), &attribsCount);
 }
@@ -102,7 +282,23 @@ void BoneSystemManager::addModels(const std::vector<ModelPtr> &models) {
 }
 
 void BoneSystemManager::removeModel(const ModelPtr &model) {
-    m_bufferStorage.freeBlock(m_ids[model]);
+    if (m_mode == Mode::Palette) {
+        freePaletteRange(m_ids[model], model->getShape()->getBonesAmount());
+    } else {
+        m_bufferStorage.freeBlock(m_ids[model]);
+    }
+
+    // models that used the removed one's bones will write their own on the next update
+    for (auto it = m_sharedIds.begin(); it != m_sharedIds.end();) {
+        if (it->second == m_ids[model]) {
+            it = m_sharedIds.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_sharedIds.erase(model);
+    m_writtenVersions.erase(model);
     m_ids.erase(model);
 }
 
@@ -112,6 +308,18 @@ void BoneSystemManager::removeModels(const std::vector<ModelPtr> &models) {
     }
 }
 
+BoneSystemManager::Mode BoneSystemManager::getMode() const {
+    return m_mode;
+}
+
+BoneSystemManager::BoneFormat BoneSystemManager::getBoneFormat() const {
+    return m_boneFormat;
+}
+
+uint BoneSystemManager::getPaletteSlot() const {
+    return m_paletteSlot;
+}
+
 uint BoneSystemManager::getBindingPoint() const {
     return m_uniformBlock.getBindingPoint();
 }
@@ -128,17 +336,92 @@ const BlockBufferStorage& BoneSystemManager::getBlockBufferStorage() const {
     return m_bufferStorage;
 }
 
+TextureBuffer* BoneSystemManager::getPalette() const {
+    return m_paletteTexture;
+}
+
 uint BoneSystemManager::getAttribsCount(const uint bonesPerVertex) {
     return bonesPerVertex / 4 + (bonesPerVertex % 4 == 0 ? 0 : 1);
 }
 
+float BoneSystemManager::toDualQuaternion(const mat4 &bone, vec4 &real, vec4 &dual) {
+    vec3 x(bone[0]), y(bone[1]), z(bone[2]);
+
+    float scale = (length(x) + length(y) + length(z)) / 3.0f;
+
+    if (scale == 0.0f)
+        scale = 1.0f;
+
+    quat rotation = normalize(quat_cast(mat3(x / scale, y / scale, z / scale)));
+
+    vec3 t(bone[3]);
+    quat translation = quat(0.0f, t.x, t.y, t.z) * rotation * 0.5f;
+
+    real = vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+    dual = vec4(translation.x, translation.y, translation.z, translation.w);
+
+    return scale;
+}
+
 void BoneSystemManager::writeBones(const ModelPtr &model, Index index) {
+    writeBones(model, [&](uint position, uint size, const void *data) {
+        m_bufferStorage.write(index, m_uniformBlock.getVarOffset(position), size, data);
+    });
+}
+
+void BoneSystemManager::writeBones(const ModelPtr &model, const function<void(uint, uint, const void*)> &write) {
     const auto &bones = *(model->getBones());
 
-    m_bufferStorage.write(
-        index, m_uniformBlock.getVarOffset(m_bonesPos),
-        sizeof(mat4) * bones.size(), value_ptr(bones[0])
-    );
+    if (m_boneFormat == BoneFormat::Matrix) {
+        write(m_bonesPos, sizeof(mat4) * bones.size(), value_ptr(bones[0]));
+        return;
+    }
+
+    m_dualQuaternions.resize(bones.size() * 2);
+    m_boneScales.resize(bones.size());
+
+    for (uint i = 0; i < bones.size(); i++) {
+        m_boneScales[i] = toDualQuaternion(bones[i], m_dualQuaternions[i * 2], m_dualQuaternions[i * 2 + 1]);
+    }
+
+    write(m_bonesPos, sizeof(vec4) * m_dualQuaternions.size(), value_ptr(m_dualQuaternions[0]));
+
+    // std140 vec4 array, so 4 scales are packed into each element
+    if (m_boneFormat == BoneFormat::ScaledDualQuaternion) {
+        write(m_boneScalesPos, sizeof(float) * m_boneScales.size(), m_boneScales.data());
+    }
+}
+
+uint BoneSystemManager::getSkippedUploads() const {
+    return m_skippedUploads;
+}
+
+void BoneSystemManager::resetSkippedUploads() {
+    m_skippedUploads = 0;
+}
+
+bool BoneSystemManager::isBonesChanged(const ModelPtr &model) {
+    WrittenVersion version {model->getBones(), model->getBonesVersion()};
+
+    if (auto it = m_writtenVersions.find(model); it != m_writtenVersions.end()) {
+        auto &written = it->second;
+
+        if (written.bones == version.bones && written.version == version.version)
+            return false;
+
+        written = version;
+    } else {
+        m_writtenVersions[model] = version;
+    }
+
+    return true;
+}
+
+uint BoneSystemManager::getLinkedId(const ModelPtr &model) {
+    if (auto it = m_sharedIds.find(model); it != m_sharedIds.end())
+        return it->second;
+
+    return m_ids[model];
 }
 
 void BoneSystemManager::linkUniformBuffer(Index blockIndex) {
@@ -147,4 +430,116 @@ void BoneSystemManager::linkUniformBuffer(Index blockIndex) {
         m_uniformBlock.linkBuffer(m_bufferStorage.getBlockSize() * blockIndex, m_uniformBlock.getSize());
     }
 }
+
+Index BoneSystemManager::allocatePaletteRange(uint size) {
+    if (size == 0)
+        return 0;
+
+    // first fit
+    for (auto it = m_paletteFreeRanges.begin(); it != m_paletteFreeRanges.end(); ++it) {
+        if (it->second >= size) {
+            Index offset = it->first;
+            uint rest = it->second - size;
+
+            m_paletteFreeRanges.erase(it);
+
+            if (rest > 0)
+                m_paletteFreeRanges[offset + size] = rest;
+
+            return offset;
+        }
+    }
+
+    // grow palette and try again
+    uint oldSize = m_paletteSize;
+    uint newSize = std::max(oldSize * 2, oldSize + size);
+
+    m_paletteSize = newSize;
+    m_palette.resize(newSize * getTexelsPerBone(), vec4(0.0f));
+    m_paletteResized = true;
+
+    freePaletteRange(oldSize, newSize - oldSize);
+
+    return allocatePaletteRange(size);
+}
+
+void BoneSystemManager::freePaletteRange(Index offset, uint size) {
+    if (size == 0)
+        return;
+
+    auto next = m_paletteFreeRanges.lower_bound(offset);
+
+    // merge with the next range
+    if (next != m_paletteFreeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = m_paletteFreeRanges.erase(next);
+    }
+
+    // merge with the previous range
+    if (next != m_paletteFreeRanges.begin()) {
+        auto prev = std::prev(next);
+
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+
+    m_paletteFreeRanges[offset] = size;
+}
+
+void BoneSystemManager::writePaletteBones(const ModelPtr &model, Index offset) {
+    if (!model->getShape()->isBonesPresent())
+        return;
+
+    const auto &bones = *(model->getBones());
+    uint texels = getTexelsPerBone();
+
+    if (m_boneFormat == BoneFormat::Matrix) {
+        memcpy(&m_palette[offset * texels], value_ptr(bones[0]), sizeof(mat4) * bones.size());
+        return;
+    }
+
+    for (uint i = 0; i < bones.size(); i++) {
+        vec4 *bone = &m_palette[(offset + i) * texels];
+        float scale = toDualQuaternion(bones[i], bone[0], bone[1]);
+
+        if (m_boneFormat == BoneFormat::ScaledDualQuaternion) {
+            bone[2] = vec4(scale, 0.0f, 0.0f, 0.0f);
+        }
+    }
+}
+
+void BoneSystemManager::uploadPalette() {
+    uint size = sizeof(vec4) * m_palette.size();
+
+    if (size == 0)
+        return;
+
+    m_paletteBuffer->bind();
+
+    if (m_paletteResized) {
+        m_paletteBuffer->setData(size, value_ptr(m_palette[0]), Buffer::DynamicDraw);
+    } else {
+        m_paletteBuffer->updateData(0, size, value_ptr(m_palette[0]));
+    }
+
+    m_paletteBuffer->unbind();
+
+    if (m_paletteResized) {
+        m_paletteTexture->bind();
+        m_paletteTexture->setBuffer(m_paletteBuffer);
+        m_paletteTexture->unbind();
+
+        m_paletteResized = false;
+    }
+}
+
+uint BoneSystemManager::getTexelsPerBone() const {
+    switch (m_boneFormat) {
+        case BoneFormat::DualQuaternion: return 2;
+        case BoneFormat::ScaledDualQuaternion: return 3;
+        default: return 4;
+    }
+}
 }
@@ -37,6 +37,10 @@ Bone& BonesStorage::operator[](Index index) {
     return m_bones[index];
 }
 
+const Bone& BonesStorage::operator[](Index index) const {
+    return m_bones[index];
+}
+
 std::vector<Bone>& BonesStorage::data() {
     return m_bones;
 }
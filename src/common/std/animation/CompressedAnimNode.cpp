@@ -0,0 +1,131 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/CompressedAnimNode.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+constexpr float quantizationMax = 65535.0f;
+constexpr float rotationComponentMax = 32767.0f;
+constexpr float rotationComponentRange = 0.70710678f; // 1 / sqrt(2)
+
+void CompressedAnimNode::Range::encode(const vec3 &value, uint16 *out) const {
+    for (int i = 0; i < 3; i++) {
+        float normalized = extent[i] != 0.0f ? (value[i] - min[i]) / extent[i] : 0.0f;
+        out[i] = static_cast<uint16>(std::round(std::clamp(normalized, 0.0f, 1.0f) * quantizationMax));
+    }
+}
+
+vec3 CompressedAnimNode::Range::decode(const uint16 *value) const {
+    return {
+        min.x + extent.x * (static_cast<float>(value[0]) / quantizationMax),
+        min.y + extent.y * (static_cast<float>(value[1]) / quantizationMax),
+        min.z + extent.z * (static_cast<float>(value[2]) / quantizationMax)
+    };
+}
+
+void CompressedAnimNode::encodeRotation(const quat &rotation, uint16 *out) {
+    quat q = normalize(rotation);
+
+    int largest = 0;
+
+    for (int i = 1; i < 4; i++) {
+        if (std::abs(q[i]) > std::abs(q[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q represent the same rotation, so the dropped component is always positive
+    float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i == largest)
+            continue;
+
+        float normalized = (sign * q[i] / rotationComponentRange) * 0.5f + 0.5f;
+        out[j++] = static_cast<uint16>(std::round(std::clamp(normalized, 0.0f, 1.0f) * rotationComponentMax));
+    }
+
+    // the index of the dropped component is stored in the high bits of the first two values
+    out[0] |= static_cast<uint16>((largest & 1) << 15);
+    out[1] |= static_cast<uint16>((largest >> 1) << 15);
+}
+
+quat CompressedAnimNode::decodeRotation(const uint16 *value) {
+    int largest = (value[0] >> 15) | ((value[1] >> 15) << 1);
+
+    quat q;
+    float sum = 0.0f;
+
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i == largest)
+            continue;
+
+        float normalized = static_cast<float>(value[j++] & 0x7fff) / rotationComponentMax;
+        q[i] = (normalized * 2.0f - 1.0f) * rotationComponentRange;
+        sum += q[i] * q[i];
+    }
+
+    q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+    return q;
+}
+
+/**
+ * @return index of the key that starts the segment containing <code>frame</code>
+ */
+inline usize findKey(float frame, const vector<CompressedAnimNode::Key> &keys) {
+    auto it = upper_bound(keys.begin(), keys.end(), frame, [](float f, const CompressedAnimNode::Key &key) {
+        return f < static_cast<float>(key.frame);
+    });
+
+    return it == keys.begin() ? 0 : static_cast<usize>(it - keys.begin()) - 1;
+}
+
+inline vec3 sampleVec(float frame, const vector<CompressedAnimNode::Key> &keys, const CompressedAnimNode::Range &range) {
+    usize index = findKey(frame, keys);
+
+    if (index + 1 >= keys.size())
+        return range.decode(keys[index].value);
+
+    const auto &start = keys[index];
+    const auto &end = keys[index + 1];
+
+    float factor = std::clamp((frame - start.frame) / static_cast<float>(end.frame - start.frame), 0.0f, 1.0f);
+
+    return mix(range.decode(start.value), range.decode(end.value), factor);
+}
+
+vec3 CompressedAnimNode::samplePosition(float frame, const Range &range) const {
+    return sampleVec(frame, positionKeys, range);
+}
+
+vec3 CompressedAnimNode::sampleScaling(float frame, const Range &range) const {
+    return sampleVec(frame, scalingKeys, range);
+}
+
+quat CompressedAnimNode::sampleRotation(float frame) const {
+    usize index = findKey(frame, rotationKeys);
+
+    if (index + 1 >= rotationKeys.size())
+        return decodeRotation(rotationKeys[index].value);
+
+    const auto &start = rotationKeys[index];
+    const auto &end = rotationKeys[index + 1];
+
+    float factor = std::clamp((frame - start.frame) / static_cast<float>(end.frame - start.frame), 0.0f, 1.0f);
+
+    return normalize(slerp(decodeRotation(start.value), decodeRotation(end.value), factor));
+}
+
+usize CompressedAnimNode::getSizeInBytes() const {
+    return (scalingKeys.size() + positionKeys.size() + rotationKeys.size()) * sizeof(Key);
+}
+
+bool CompressedAnimNode::empty() const {
+    return scalingKeys.empty() && positionKeys.empty() && rotationKeys.empty();
+}
+}
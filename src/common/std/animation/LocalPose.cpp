@@ -0,0 +1,39 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/LocalPose.h>
+
+#include <glm/gtx/quaternion.hpp>
+
+using namespace glm;
+
+namespace algine {
+mat4 JointTransform::toMat4() const {
+    return glm::translate(mat4(1.0f), translation) * glm::toMat4(rotation) * glm::scale(mat4(1.0f), scale);
+}
+
+// nlerp through the shortest arc: cheaper than slerp and good enough for blending
+inline quat nlerp(const quat &lhs, const quat &rhs, float factor) {
+    quat end = dot(lhs, rhs) < 0.0f ? -rhs : rhs;
+    return normalize(lhs * (1.0f - factor) + end * factor);
+}
+
+JointTransform JointTransform::lerp(const JointTransform &lhs, const JointTransform &rhs, float factor) {
+    JointTransform result;
+    result.translation = mix(lhs.translation, rhs.translation, factor);
+    result.rotation = nlerp(lhs.rotation, rhs.rotation, factor);
+    result.scale = mix(lhs.scale, rhs.scale, factor);
+    return result;
+}
+
+JointTransform JointTransform::add(const JointTransform &base, const JointTransform &pose,
+                                   const JointTransform &reference, float factor)
+{
+    quat deltaRotation = inverse(reference.rotation) * pose.rotation;
+    vec3 deltaScale = pose.scale / reference.scale;
+
+    JointTransform result;
+    result.translation = base.translation + (pose.translation - reference.translation) * factor;
+    result.rotation = normalize(base.rotation * nlerp(quat(1.0f, 0.0f, 0.0f, 0.0f), deltaRotation, factor));
+    result.scale = base.scale * mix(vec3(1.0f), deltaScale, factor);
+    return result;
+}
+}
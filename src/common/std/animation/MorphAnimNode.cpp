@@ -0,0 +1,21 @@
+#include <algine/std/animation/MorphAnimNode.h>
+
+#include <assimp/anim.h>
+
+namespace algine {
+MorphAnimNode::MorphAnimNode(const aiMeshMorphAnim *morphAnim) {
+    name = morphAnim->mName.data;
+    meshNames = {name};
+
+    keys.resize(morphAnim->mNumKeys);
+
+    for (uint i = 0; i < morphAnim->mNumKeys; i++) {
+        const aiMeshMorphKey &src = morphAnim->mKeys[i];
+        Key &key = keys[i];
+
+        key.time = src.mTime;
+        key.targets.assign(src.mValues, src.mValues + src.mNumValuesAndWeights);
+        key.weights.assign(src.mWeights, src.mWeights + src.mNumValuesAndWeights);
+    }
+}
+}
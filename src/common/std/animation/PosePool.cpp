@@ -0,0 +1,53 @@
+#include <algine/std/animation/PosePool.h>
+
+#include <algine/core/PtrMaker.h>
+
+using namespace std;
+
+namespace algine {
+PosePool::Slot PosePool::acquire(uint bonesCount) {
+    if (auto it = m_freeSlots.find(bonesCount); it != m_freeSlots.end() && !it->second.empty()) {
+        Slot slot = it->second.back();
+        it->second.pop_back();
+        m_freeSlotsCount--;
+        m_generations[slot] = ++m_generation;
+        return slot;
+    }
+
+    m_slots.emplace_back(bonesCount);
+    m_generations.emplace_back(++m_generation);
+
+    return m_slots.size() - 1;
+}
+
+void PosePool::release(Slot slot) {
+    m_freeSlots[m_slots[slot].size()].emplace_back(slot);
+    m_freeSlotsCount++;
+}
+
+BoneMatrices& PosePool::get(Slot slot) {
+    return m_slots[slot];
+}
+
+const BoneMatrices& PosePool::get(Slot slot) const {
+    return m_slots[slot];
+}
+
+uint PosePool::getGeneration(Slot slot) const {
+    return m_generations[slot];
+}
+
+uint PosePool::getSlotsCount() const {
+    return m_slots.size();
+}
+
+uint PosePool::getFreeSlotsCount() const {
+    return m_freeSlotsCount;
+}
+
+const PosePoolPtr& PosePool::getDefault() {
+    // models hold their pools, so the default one outlives them
+    static PosePoolPtr pool = PtrMaker::make();
+    return pool;
+}
+}
@@ -0,0 +1,97 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/SharedPoseCache.h>
+
+#include <algine/std/animation/Animator.h>
+#include <algine/std/model/Model.h>
+#include <algine/std/model/Shape.h>
+
+#include <functional>
+#include <stdexcept>
+#include <cmath>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+bool SharedPoseCache::Key::operator==(const Key &other) const {
+    return shape == other.shape && animationIndex == other.animationIndex && tick == other.tick;
+}
+
+size_t SharedPoseCache::KeyHash::operator()(const Key &key) const {
+    size_t hash = std::hash<const Shape*>()(key.shape);
+    hash ^= std::hash<Index>()(key.animationIndex) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int64>()(key.tick) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+void SharedPoseCache::beginFrame() {
+    m_keys.clear();
+    m_usedPalettes = 0;
+    m_requestsCount = 0;
+    m_evaluationsCount = 0;
+}
+
+void SharedPoseCache::animate(const ModelPtr &model, float timeInSeconds) {
+    m_requestsCount++;
+
+    auto animator = model->getAnimator();
+    auto tick = static_cast<int64>(std::floor(timeInSeconds / m_timeStep));
+    float time = static_cast<float>(tick) * m_timeStep;
+
+    // copy on write: model has its own bones
+    if (model->isBoneTransformationsCustom()) {
+        animator->animate(time);
+        model->setBonesFromAnimation(animator->getAnimationIndex());
+        m_evaluationsCount++;
+        return;
+    }
+
+    const auto &shape = *model->getShape();
+
+    Key key {&shape, animator->getAnimationIndex(), tick};
+
+    // palettes are recycled every frame, so their content is always new
+    if (auto it = m_keys.find(key); it != m_keys.end()) {
+        model->setBones(&m_palettes[it->second]);
+        return;
+    }
+
+    Index index = m_usedPalettes++;
+
+    if (index == m_palettes.size())
+        m_palettes.emplace_back();
+
+    auto &bones = m_palettes[index];
+    bones.resize(shape.getBonesAmount());
+
+    if (m_identityTransformations.size() < bones.size())
+        m_identityTransformations.resize(bones.size(), mat4(1.0f));
+
+    Animator::samplePose(shape, key.animationIndex, time, m_pose);
+    Animator::computeBones(shape, m_pose, m_identityTransformations, m_globals, bones);
+
+    m_keys[key] = index;
+    m_evaluationsCount++;
+
+    model->setBones(&bones);
+}
+
+void SharedPoseCache::setTimeStep(float step) {
+    if (step <= 0.0f)
+        throw invalid_argument("Time step must be positive");
+
+    m_timeStep = step;
+}
+
+float SharedPoseCache::getTimeStep() const {
+    return m_timeStep;
+}
+
+uint SharedPoseCache::getRequestsCount() const {
+    return m_requestsCount;
+}
+
+uint SharedPoseCache::getEvaluationsCount() const {
+    return m_evaluationsCount;
+}
+}
@@ -0,0 +1,105 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/animation/Skeleton.h>
+
+#include <algine/std/model/Shape.h>
+#include <algine/std/Node.h>
+
+#include <glm/gtx/matrix_decompose.hpp>
+
+#include <unordered_map>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+void Skeleton::build(const Shape &shape) {
+    m_joints.clear();
+    m_channels.clear();
+
+    addJoint(shape.getRootNode(), None, shape);
+
+    unordered_map<string, Index> jointIndices;
+
+    for (Index i = 0; i < m_joints.size(); i++)
+        jointIndices[m_joints[i].name] = i;
+
+    m_channels.resize(shape.getAnimationsAmount());
+
+    for (Index i = 0; i < m_channels.size(); i++) {
+        auto &channels = m_channels[i];
+        channels.assign(m_joints.size(), None);
+
+        const auto &animation = shape.getAnimation(i);
+
+        for (Index channel = 0; channel < animation.channels.size(); channel++) {
+            if (auto it = jointIndices.find(animation.channels[channel].name); it != jointIndices.end()) {
+                channels[it->second] = channel;
+            }
+        }
+    }
+}
+
+void Skeleton::addJoint(const Node &node, Index parent, const Shape &shape) {
+    Index index = m_joints.size();
+
+    auto &joint = m_joints.emplace_back();
+    joint.name = node.name;
+    joint.parent = parent;
+    joint.bone = shape.getBones().getIndex(node.name);
+
+    vec3 skew;
+    vec4 perspective;
+    decompose(node.defaultTransform, joint.defaultTransform.scale, joint.defaultTransform.rotation,
+              joint.defaultTransform.translation, skew, perspective);
+
+    for (const auto &child : node.childs) {
+        addJoint(child, index, shape);
+    }
+}
+
+Index Skeleton::getJointIndex(const string &name) const {
+    for (Index i = 0; i < m_joints.size(); i++) {
+        if (m_joints[i].name == name) {
+            return i;
+        }
+    }
+
+    return None;
+}
+
+const Skeleton::Joint& Skeleton::getJoint(Index index) const {
+    return m_joints[index];
+}
+
+const vector<Skeleton::Joint>& Skeleton::getJoints() const {
+    return m_joints;
+}
+
+uint Skeleton::getJointsCount() const {
+    return m_joints.size();
+}
+
+const vector<Index>& Skeleton::getChannels(Index animationIndex) const {
+    return m_channels[animationIndex];
+}
+
+void Skeleton::getDefaultPose(LocalPose &out) const {
+    out.resize(m_joints.size());
+
+    for (Index i = 0; i < m_joints.size(); i++) {
+        out[i] = m_joints[i].defaultTransform;
+    }
+}
+
+BoneMask Skeleton::getLeafJoints() const {
+    BoneMask mask(m_joints.size(), true);
+
+    for (const auto &joint : m_joints) {
+        if (joint.parent != None) {
+            mask.set(joint.parent, false);
+        }
+    }
+
+    return mask;
+}
+}
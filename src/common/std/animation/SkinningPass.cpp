@@ -0,0 +1,222 @@
+#include <algine/std/animation/SkinningPass.h>
+
+#include <algine/std/model/Model.h>
+#include <algine/std/model/Shape.h>
+
+#include <algine/core/shader/ShaderProgram.h>
+
+#include <algine/constants/SkinningShader.h>
+#include <algine/constants/BoneSystem.h>
+
+#include <algine/gl.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace algine {
+SkinningPass::~SkinningPass() {
+    for (auto &p : m_outputs) {
+        auto &output = p.second;
+        ArrayBuffer::destroy(output.positions, output.normals, output.tangents, output.bitangents);
+        InputLayout::destroy(output.inputLayout);
+    }
+
+    for (auto &p : m_sourceLayouts) {
+        InputLayout::destroy(p.second);
+    }
+}
+
+void SkinningPass::init() {
+    using namespace SkinningShader::Vars;
+
+    m_program->setTransformFeedbackVaryings({OutPos, OutNormal, OutTangent, OutBitangent}, ShaderProgram::SeparateAttribs);
+    m_program->link();
+    m_program->loadActiveLocations();
+
+    m_inPosLocation = m_program->getLocation(InPos);
+    m_inNormalLocation = m_program->getLocation(InNormal);
+    m_inTangentLocation = m_program->getLocation(InTangent);
+    m_inBitangentLocation = m_program->getLocation(InBitangent);
+}
+
+void SkinningPass::skin() {
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    m_program->bind();
+
+    for (const auto &p : m_outputs) {
+        const auto &model = p.first;
+        const auto &output = p.second;
+
+        m_boneSystemManager->linkBuffer(model, m_program.get());
+
+        auto sourceLayout = getSourceLayout(model->getShape().get());
+        sourceLayout->bind();
+
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, output.positions->getId());
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 1, output.normals->getId());
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 2, output.tangents->getId());
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 3, output.bitangents->getId());
+
+        glBeginTransformFeedback(GL_POINTS);
+        glDrawArrays(GL_POINTS, 0, static_cast<int>(output.verticesCount));
+        glEndTransformFeedback();
+
+        sourceLayout->unbind();
+    }
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 1, 0);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 2, 0);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 3, 0);
+
+    m_program->unbind();
+
+    glDisable(GL_RASTERIZER_DISCARD);
+}
+
+void SkinningPass::addModel(const ModelPtr &model, const InputLayoutShapeLocations &locations) {
+    const auto &shape = model->getShape();
+
+    if (!shape->isBonesPresent())
+        throw invalid_argument("Model has no bones, there is nothing to skin");
+
+    Output output;
+
+    auto vertices = shape->getVerticesBuffer();
+    vertices->bind();
+    output.verticesCount = vertices->size() / (3 * sizeof(float));
+    vertices->unbind();
+
+    uint size = output.verticesCount * 3 * sizeof(float);
+
+    // tangent buffers are needed even if the shape has no tangents,
+    // since every varying must have a transform feedback buffer
+    ArrayBuffer::create(output.positions, output.normals, output.tangents, output.bitangents);
+
+    for (auto buffer : {output.positions, output.normals, output.tangents, output.bitangents}) {
+        buffer->bind();
+        buffer->setData(size, nullptr, Buffer::StreamDraw);
+        buffer->unbind();
+    }
+
+    // the same as Shape::createInputLayout, but without bones
+    // and with skinned positions, normals, tangents & bitangents
+    output.inputLayout = new InputLayout();
+    output.inputLayout->bind();
+
+    InputAttributeDescription attribDescription;
+    attribDescription.setCount(3);
+
+    auto addAttribute = [&](int location, const ArrayBuffer *arrayBuffer) {
+        if (location != InputLayoutShapeLocations::None && arrayBuffer != nullptr) {
+            attribDescription.setLocation(location);
+            output.inputLayout->addAttribute(attribDescription, arrayBuffer);
+        }
+    };
+
+    addAttribute(locations.position, output.positions);
+    addAttribute(locations.normal, output.normals);
+    addAttribute(locations.tangent, shape->getTangentsBuffer() != nullptr ? output.tangents : nullptr);
+    addAttribute(locations.bitangent, shape->getBitangentsBuffer() != nullptr ? output.bitangents : nullptr);
+
+    attribDescription.setCount(2);
+    addAttribute(locations.texCoord, shape->getTexCoordsBuffer());
+
+    output.inputLayout->setIndexBuffer(shape->getIndicesBuffer());
+    output.inputLayout->unbind();
+
+    m_outputs[model] = output;
+}
+
+void SkinningPass::removeModel(const ModelPtr &model) {
+    if (auto it = m_outputs.find(model); it != m_outputs.end()) {
+        auto &output = it->second;
+        ArrayBuffer::destroy(output.positions, output.normals, output.tangents, output.bitangents);
+        InputLayout::destroy(output.inputLayout);
+        m_outputs.erase(it);
+    }
+}
+
+void SkinningPass::setShaderProgram(const ShaderProgramPtr &program) {
+    m_program = program;
+}
+
+void SkinningPass::setBoneSystemManager(BoneSystemManager *manager) {
+    m_boneSystemManager = manager;
+}
+
+const ShaderProgramPtr& SkinningPass::getShaderProgram() const {
+    return m_program;
+}
+
+BoneSystemManager* SkinningPass::getBoneSystemManager() const {
+    return m_boneSystemManager;
+}
+
+InputLayout* SkinningPass::getInputLayout(const ModelPtr &model) const {
+    return m_outputs.at(model).inputLayout;
+}
+
+ArrayBuffer* SkinningPass::getPositionsBuffer(const ModelPtr &model) const {
+    return m_outputs.at(model).positions;
+}
+
+ArrayBuffer* SkinningPass::getNormalsBuffer(const ModelPtr &model) const {
+    return m_outputs.at(model).normals;
+}
+
+ArrayBuffer* SkinningPass::getTangentsBuffer(const ModelPtr &model) const {
+    return m_outputs.at(model).tangents;
+}
+
+ArrayBuffer* SkinningPass::getBitangentsBuffer(const ModelPtr &model) const {
+    return m_outputs.at(model).bitangents;
+}
+
+InputLayout* SkinningPass::getSourceLayout(Shape *shape) {
+    if (auto it = m_sourceLayouts.find(shape); it != m_sourceLayouts.end())
+        return it->second;
+
+    using namespace Module::BoneSystem::Vars;
+
+    auto inputLayout = new InputLayout();
+    inputLayout->bind();
+
+    InputAttributeDescription attribDescription;
+    attribDescription.setCount(3);
+
+    attribDescription.setLocation(m_inPosLocation);
+    inputLayout->addAttribute(attribDescription, shape->getVerticesBuffer());
+
+    attribDescription.setLocation(m_inNormalLocation);
+    inputLayout->addAttribute(attribDescription, shape->getNormalsBuffer());
+
+    // if disabled, attributes are zero and so are the skinned ones
+    if (shape->getTangentsBuffer() != nullptr && m_inTangentLocation != -1) {
+        attribDescription.setLocation(m_inTangentLocation);
+        inputLayout->addAttribute(attribDescription, shape->getTangentsBuffer());
+    }
+
+    if (shape->getBitangentsBuffer() != nullptr && m_inBitangentLocation != -1) {
+        attribDescription.setLocation(m_inBitangentLocation);
+        inputLayout->addAttribute(attribDescription, shape->getBitangentsBuffer());
+    }
+
+    attribDescription.setCount(4);
+
+    attribDescription.setLocation(m_program->getLocation(InBoneWeights));
+    inputLayout->addAttribute(attribDescription, shape->getBoneWeightsBuffer());
+
+    attribDescription.setLocation(m_program->getLocation(InBoneIds));
+    attribDescription.setDataType(DataType::UnsignedInt);
+    inputLayout->addAttribute(attribDescription, shape->getBoneIdsBuffer());
+
+    inputLayout->unbind();
+
+    m_sourceLayouts[shape] = inputLayout;
+
+    return inputLayout;
+}
+}
@@ -2,7 +2,9 @@
 #define ALGINE_ASSIMP2GLM_H
 
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
 #include <assimp/matrix4x4.h>
+#include <assimp/vector3.h>
 
 inline glm::mat4 getMat4(const aiMatrix4x4 &aiMat) {
     glm::mat4 mat;
@@ -30,4 +32,8 @@ inline glm::mat4 getMat4(const aiMatrix4x4 &aiMat) {
     return mat;
 }
 
+inline glm::vec3 getVec3(const aiVector3D &aiVec) {
+    return {aiVec.x, aiVec.y, aiVec.z};
+}
+
 #endif //ALGINE_ASSIMP2GLM_H
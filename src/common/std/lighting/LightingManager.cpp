@@ -1,12 +1,14 @@
 #include <algine/std/lighting/LightingManager.h>
+#include <algine/std/lighting/LightingBlock.h>
 
 #include <algine/core/Engine.h>
 #include <algine/constants/Lighting.h>
 #include <algine/constants/ShadowShader.h>
 
-#include <tulz/macros.h>
+#include "internal/SOP.h"
+
+#include <string>
 
-using namespace tulz;
 using namespace std;
 using namespace glm;
 
@@ -18,10 +20,7 @@ LightingManager::LightingManager()
       m_lightsInitialSlot(),
       m_lightShader(),
       m_pointShadowShader(),
-      m_lightsCountOffset(),
-      m_shadowOpacityOffset(),
-      m_shadowDiskRadiusKOffset(),
-      m_shadowDiskRadiusMinOffset(),
+      m_stagingEnabled(false),
       m_shadowMapsLocations(),
       m_shadowShaderPosLoc(-1),
       m_shadowShaderFarPlaneLoc(-1),
@@ -46,93 +45,55 @@ inline uint to_uint(T t) {
 constexpr uint EDirLight = static_cast<uint>(Light::Type::Dir);
 constexpr uint EPointLight = static_cast<uint>(Light::Type::Point);
 
-// offsets; used throughout the cpp; to keep things human-readable
-enum_class(CommonLightOffsets, Kc, Kl, Kq, Pos, Color, common_elements_count)
-
-enum_class(DirLightOffsets: CommonLightOffsets,
-        MinBias = common_elements_count, MaxBias, LightMatrix, elements_count)
-
-enum_class(PointLightOffsets: CommonLightOffsets,
-        Far = common_elements_count, Bias, elements_count)
-
-// only for using in init()
-#define dirLightElem(elem) \
-    LightingVars::Block::DirLights + string("[") + to_string(i) + "]." + LightingVars::Light::elem
-
-#define pointLightElem(elem) \
-    LightingVars::Block::PointLights + string("[") + to_string(i) + "]." + LightingVars::Light::elem
-
-#define dirLightOffset(type) m_offsets[EDirLight][i][DirLightOffsets::type]
-#define pointLightOffset(type) m_offsets[EPointLight][i][PointLightOffsets::type]
+#define headerOffset(field) static_cast<uint>(offsetof(LightingBlock::Header, field))
+#define dirLightOffset(field) static_cast<uint>(offsetof(LightingBlock::DirLight, field))
+#define pointLightOffset(field) static_cast<uint>(offsetof(LightingBlock::PointLight, field))
 
 void LightingManager::init() {
     const auto lightShaderRaw = m_lightShader.get();
 
+    // std140: layout is known, so there is no need to query offsets
+    uint blockSize = LightingBlock::getSize(m_lightsLimit[EDirLight], m_lightsLimit[EPointLight]);
+
     m_uniformBlock.setName(LightingVars::Block::Name);
+
+#ifdef ALGINE_SECURE_OPERATIONS
     m_uniformBlock.init(lightShaderRaw);
 
+    if (m_uniformBlock.getSize() != blockSize) {
+        ALGINE_SOP_ERROR(
+            "Lighting block size mismatch: " + to_string(m_uniformBlock.getSize()) + " in shader, " +
+            to_string(blockSize) + " expected. Lights limits must match the shader ones"
+        );
+    }
+#endif
+
+    m_uniformBlock.setSize(blockSize);
+
     auto uniformBuffer = new UniformBuffer();
 
     m_bufferWriter.setBuffer(uniformBuffer);
 
     m_uniformBlock.setBuffer(uniformBuffer);
     m_uniformBlock.allocateSuitableBufferSize();
+
+    if (m_stagingEnabled) {
+        m_bufferWriter.enableMirror(m_uniformBlock.getSize());
+    } else {
+        m_bufferWriter.disableMirror();
+    }
+
     m_uniformBlock.assignBindingPoint(lightShaderRaw);
     m_uniformBlock.linkBuffer();
 
-    m_lightsCountOffset[EDirLight] = BaseUniformBlock::getVarOffset(
-            LightingVars::Block::DirLightsCount, lightShaderRaw);
-    m_lightsCountOffset[EPointLight] = BaseUniformBlock::getVarOffset(
-            LightingVars::Block::PointLightsCount, lightShaderRaw);
     m_shadowMapsLocations[EDirLight] = m_lightShader->getLocation(LightingVars::DirLightShadowMaps);
     m_shadowMapsLocations[EPointLight] = m_lightShader->getLocation(LightingVars::PointLightShadowMaps);
 
-    m_shadowOpacityOffset = BaseUniformBlock::getVarOffset(
-            LightingVars::Block::ShadowOpacity, lightShaderRaw);
-    m_shadowDiskRadiusKOffset = BaseUniformBlock::getVarOffset(
-            LightingVars::Block::ShadowDiskRadiusK, lightShaderRaw);
-    m_shadowDiskRadiusMinOffset = BaseUniformBlock::getVarOffset(
-            LightingVars::Block::ShadowDiskRadiusMin, lightShaderRaw);
-
     if (m_pointShadowShader) {
         m_shadowShaderPosLoc = m_pointShadowShader->getLocation(ShadowShader::Vars::PointLight::Pos);
         m_shadowShaderFarPlaneLoc = m_pointShadowShader->getLocation(ShadowShader::Vars::PointLight::FarPlane);
         m_shadowShaderMatricesLoc = m_pointShadowShader->getLocation(ShadowShader::Vars::PointLight::ShadowMatrices);
     }
-
-    m_offsets[EDirLight] = Array<LightOffsets>(m_lightsLimit[EDirLight]);
-    m_offsets[EPointLight] = Array<LightOffsets>(m_lightsLimit[EPointLight]);
-
-#define getDirLightOffset(elem) BaseUniformBlock::getVarOffset(dirLightElem(elem), lightShaderRaw)
-#define getPointLightOffset(elem) BaseUniformBlock::getVarOffset(pointLightElem(elem), lightShaderRaw)
-
-    // dir light offsets
-    for (uint i = 0; i < m_lightsLimit[EDirLight]; ++i) {
-        m_offsets[EDirLight][i] = LightOffsets(DirLightOffsets::elements_count);
-        dirLightOffset(Kc) = getDirLightOffset(Kc);
-        dirLightOffset(Kl) = getDirLightOffset(Kl);
-        dirLightOffset(Kq) = getDirLightOffset(Kq);
-        dirLightOffset(Pos) = getDirLightOffset(Pos);
-        dirLightOffset(Color) = getDirLightOffset(Color);
-        dirLightOffset(MinBias) = getDirLightOffset(MinBias);
-        dirLightOffset(MaxBias) = getDirLightOffset(MaxBias);
-        dirLightOffset(LightMatrix) = getDirLightOffset(LightMatrix);
-    }
-
-    // point light offsets
-    for (uint i = 0; i < m_lightsLimit[EPointLight]; ++i) {
-        m_offsets[EPointLight][i] = LightOffsets(PointLightOffsets::elements_count);
-        pointLightOffset(Kc) = getPointLightOffset(Kc);
-        pointLightOffset(Kl) = getPointLightOffset(Kl);
-        pointLightOffset(Kq) = getPointLightOffset(Kq);
-        pointLightOffset(Pos) = getPointLightOffset(Pos);
-        pointLightOffset(Color) = getPointLightOffset(Color);
-        pointLightOffset(Far) = getPointLightOffset(FarPlane);
-        pointLightOffset(Bias) = getPointLightOffset(Bias);
-    }
-
-#undef getPointLightOffset
-#undef getDirLightOffset
 }
 
 void LightingManager::configureShadowMapping() {
@@ -172,6 +133,10 @@ void LightingManager::setPointLightShadowShader(const ShaderProgramPtr &shadowSh
     m_pointShadowShader = shadowShader;
 }
 
+void LightingManager::setStagingEnabled(bool enabled) {
+    m_stagingEnabled = enabled;
+}
+
 uint LightingManager::getLightsLimit(Light::Type lightType) const {
     return m_lightsLimit[to_uint(lightType)];
 }
@@ -188,6 +153,10 @@ const ShaderProgramPtr& LightingManager::getPointLightShadowShader() const {
     return m_pointShadowShader;
 }
 
+bool LightingManager::isStagingEnabled() const {
+    return m_stagingEnabled;
+}
+
 const BaseUniformBlock& LightingManager::getUniformBlock() const {
     return m_uniformBlock;
 }
@@ -226,65 +195,113 @@ void LightingManager::pushShadowShaderMatrices(const PointLight &light) {
     }
 }
 
+void LightingManager::flush() {
+    m_bufferWriter.flush();
+}
+
+const BufferMirror::Stats& LightingManager::getFlushStats() const {
+    return m_bufferWriter.getMirror().getStats();
+}
+
 void LightingManager::writeDirLightsCount(uint count) {
-    m_bufferWriter.write(m_lightsCountOffset[EDirLight], count);
+    m_bufferWriter.write(headerOffset(dirLightsCount), count);
 }
 
 void LightingManager::writePointLightsCount(uint count) {
-    m_bufferWriter.write(m_lightsCountOffset[EPointLight], count);
+    m_bufferWriter.write(headerOffset(pointLightsCount), count);
 }
 
 void LightingManager::writeShadowOpacity(float shadowOpacity) {
-    m_bufferWriter.write(m_shadowOpacityOffset, shadowOpacity);
+    m_bufferWriter.write(headerOffset(shadowOpacity), shadowOpacity);
 }
 
 void LightingManager::writeShadowDiskRadiusK(float diskRadiusK) {
-    m_bufferWriter.write(m_shadowDiskRadiusKOffset, diskRadiusK);
+    m_bufferWriter.write(headerOffset(diskRadiusK), diskRadiusK);
 }
 
 void LightingManager::writeShadowDiskRadiusMin(float diskRadiusMin) {
-    m_bufferWriter.write(m_shadowDiskRadiusMinOffset, diskRadiusMin);
+    m_bufferWriter.write(headerOffset(diskRadiusMin), diskRadiusMin);
 }
 
-#define lightOffsets m_offsets[to_uint(light.m_type)][index]
+void LightingManager::writeLight(const DirLight &light, uint index) {
+    LightingBlock::DirLight data {};
+    data.pos = light.m_pos;
+    data.kc = light.m_kc;
+    data.color = light.m_color;
+    data.kl = light.m_kl;
+    data.kq = light.m_kq;
+    data.minBias = light.m_minBias;
+    data.maxBias = light.m_maxBias;
+    data.lightMatrix = light.m_lightSpace;
+
+    m_bufferWriter.write(getLightOffset(light, index), data);
+}
+
+void LightingManager::writeLight(const PointLight &light, uint index) {
+    LightingBlock::PointLight data {};
+    data.pos = light.m_pos;
+    data.kc = light.m_kc;
+    data.color = light.m_color;
+    data.kl = light.m_kl;
+    data.kq = light.m_kq;
+    data.far = light.m_far;
+    data.bias = light.m_bias;
+
+    m_bufferWriter.write(getLightOffset(light, index), data);
+}
+
+// common fields have the same offsets in both structures
+static_assert(offsetof(LightingBlock::DirLight, kc) == offsetof(LightingBlock::PointLight, kc), "");
+static_assert(offsetof(LightingBlock::DirLight, kl) == offsetof(LightingBlock::PointLight, kl), "");
+static_assert(offsetof(LightingBlock::DirLight, kq) == offsetof(LightingBlock::PointLight, kq), "");
+static_assert(offsetof(LightingBlock::DirLight, pos) == offsetof(LightingBlock::PointLight, pos), "");
+static_assert(offsetof(LightingBlock::DirLight, color) == offsetof(LightingBlock::PointLight, color), "");
 
 void LightingManager::writeKc(const Light &light, uint index) {
-    m_bufferWriter.write(lightOffsets[CommonLightOffsets::Kc], light.m_kc);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(kc), light.m_kc);
 }
 
 void LightingManager::writeKl(const Light &light, uint index) {
-    m_bufferWriter.write(lightOffsets[CommonLightOffsets::Kl], light.m_kl);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(kl), light.m_kl);
 }
 
 void LightingManager::writeKq(const Light &light, uint index) {
-    m_bufferWriter.write(lightOffsets[CommonLightOffsets::Kq], light.m_kq);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(kq), light.m_kq);
 }
 
 void LightingManager::writePos(const Light &light, uint index) {
-    m_bufferWriter.write(lightOffsets[CommonLightOffsets::Pos], light.m_pos);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(pos), light.m_pos);
 }
 
 void LightingManager::writeColor(const Light &light, uint index) {
-    m_bufferWriter.write(lightOffsets[CommonLightOffsets::Color], light.m_color);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(color), light.m_color);
 }
 
 void LightingManager::writeMinBias(const DirLight &light, uint index) {
-    m_bufferWriter.write(lightOffsets[DirLightOffsets::MinBias], light.m_minBias);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(minBias), light.m_minBias);
 }
 
 void LightingManager::writeMaxBias(const DirLight &light, uint index) {
-    m_bufferWriter.write(lightOffsets[DirLightOffsets::MaxBias], light.m_maxBias);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(maxBias), light.m_maxBias);
 }
 
 void LightingManager::writeLightMatrix(const DirLight &light, uint index) {
-    m_bufferWriter.write(lightOffsets[DirLightOffsets::LightMatrix], light.m_lightSpace);
+    m_bufferWriter.write(getLightOffset(light, index) + dirLightOffset(lightMatrix), light.m_lightSpace);
 }
 
 void LightingManager::writeFarPlane(const PointLight &light, uint index) {
-    m_bufferWriter.write(lightOffsets[PointLightOffsets::Far], light.m_far);
+    m_bufferWriter.write(getLightOffset(light, index) + pointLightOffset(far), light.m_far);
 }
 
 void LightingManager::writeBias(const PointLight &light, uint index) {
-    m_bufferWriter.write(lightOffsets[PointLightOffsets::Bias], light.m_bias);
+    m_bufferWriter.write(getLightOffset(light, index) + pointLightOffset(bias), light.m_bias);
+}
+
+uint LightingManager::getLightOffset(const Light &light, uint index) const {
+    if (light.m_type == Light::Type::Dir) {
+        return LightingBlock::getDirLightOffset(index);
+    } else {
+        return LightingBlock::getPointLightOffset(m_lightsLimit[EDirLight], index);
+    }
+}
 }
-}
\ No newline at end of file
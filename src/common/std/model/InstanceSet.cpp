@@ -0,0 +1,207 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/model/InstanceSet.h>
+
+#include <algine/std/model/Shape.h>
+#include <algine/core/Engine.h>
+
+#include <tulz/macros.h>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+constexpr uint transformSize = 16; // in floats
+
+InstanceSet::InstanceSet(const ShapePtr &shape)
+    : m_shape(shape)
+{
+    m_buffer = new ArrayBuffer();
+}
+
+InstanceSet::~InstanceSet() {
+    deletePtr(m_buffer)
+}
+
+Index InstanceSet::addAttribute(uint location, uint count) {
+    if (count == 0 || count > 4)
+        throw invalid_argument("InstanceSet: attribute must have from 1 to 4 components");
+
+    if (!m_data.empty())
+        throw runtime_error("InstanceSet: attributes must be added before instances");
+
+    m_attributes.push_back({location, count, m_stride});
+    m_stride += count;
+
+    return m_attributes.size() - 1;
+}
+
+void InstanceSet::attach(Index inputLayoutIndex, uint transformLocation) {
+    m_inputLayout = inputLayoutIndex;
+
+    InputAttributeDescription attribDescription;
+    attribDescription.setStride(m_stride * sizeof(float));
+    attribDescription.setDivisor(1);
+    attribDescription.setCount(4);
+
+    auto inputLayout = m_shape->getInputLayout(inputLayoutIndex);
+    inputLayout->bind();
+
+    // mat4 attribute takes 4 vec4 locations, one per column
+    for (uint i = 0; i < 4; i++) {
+        attribDescription.setLocation(transformLocation + i);
+        attribDescription.setOffset(i * 4);
+        inputLayout->addAttribute(attribDescription, m_buffer);
+    }
+
+    for (const auto &attribute : m_attributes) {
+        attribDescription.setLocation(attribute.location);
+        attribDescription.setCount(attribute.count);
+        attribDescription.setOffset(attribute.offset);
+        inputLayout->addAttribute(attribDescription, m_buffer);
+    }
+
+    inputLayout->unbind();
+}
+
+Index InstanceSet::addInstance(const mat4 &transform) {
+    Index index = getInstancesCount();
+
+    m_data.resize(m_data.size() + m_stride, 0.0f);
+    setTransform(index, transform);
+
+    return index;
+}
+
+void InstanceSet::setTransform(Index instance, const mat4 &transform) {
+    memcpy(this->instance(instance), value_ptr(transform), sizeof(mat4));
+}
+
+void InstanceSet::setAttribute(Index instance, Index attribute, const vec4 &value) {
+    const auto &attrib = m_attributes[attribute];
+    memcpy(this->instance(instance) + attrib.offset, value_ptr(value), attrib.count * sizeof(float));
+}
+
+void InstanceSet::reserve(uint count) {
+    m_data.reserve(count * m_stride);
+}
+
+void InstanceSet::clear() {
+    m_data.clear();
+    m_visibleCount = 0;
+}
+
+void InstanceSet::setBoundingSphere(const vec3 &center, float radius) {
+    m_boundingCenter = center;
+    m_boundingRadius = radius;
+}
+
+void InstanceSet::update() {
+    upload(m_data, getInstancesCount());
+}
+
+void InstanceSet::update(const mat4 &viewProjection) {
+    if (m_boundingRadius <= 0.0f) {
+        update();
+        return;
+    }
+
+    // Gribb-Hartmann frustum planes: row3 +- row[0..2]
+    vec4 planes[6];
+
+    for (int i = 0; i < 3; i++) {
+        vec4 row(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+        planes[i * 2] = row3 + row;
+        planes[i * 2 + 1] = row3 - row;
+    }
+
+    for (auto &plane : planes)
+        plane /= length(vec3(plane));
+
+    m_visible.resize(m_data.size());
+
+    uint visibleCount = 0;
+
+    for (Index i = 0; i < getInstancesCount(); i++) {
+        const float *data = instance(i);
+        const mat4 &transform = *reinterpret_cast<const mat4*>(data);
+
+        vec3 center(transform * vec4(m_boundingCenter, 1.0f));
+
+        float scale = std::max({length(vec3(transform[0])), length(vec3(transform[1])), length(vec3(transform[2]))});
+        float radius = m_boundingRadius * scale;
+
+        bool visible = std::all_of(std::begin(planes), std::end(planes), [&](const vec4 &plane) {
+            return dot(vec3(plane), center) + plane.w >= -radius;
+        });
+
+        if (visible) {
+            memcpy(&m_visible[visibleCount * m_stride], data, m_stride * sizeof(float));
+            visibleCount++;
+        }
+    }
+
+    upload(m_visible, visibleCount);
+}
+
+void InstanceSet::draw() const {
+    auto inputLayout = m_shape->getInputLayout(m_inputLayout);
+    inputLayout->bind();
+
+    for (Index i = 0; i < m_shape->getMeshes().size(); i++)
+        drawMesh(i);
+
+    inputLayout->unbind();
+}
+
+void InstanceSet::drawMesh(Index mesh) const {
+    if (m_visibleCount == 0)
+        return;
+
+    const auto &meshData = m_shape->getMeshes()[mesh];
+    Engine::drawElementsInstanced(meshData.start, meshData.count, m_visibleCount);
+}
+
+const ShapePtr& InstanceSet::getShape() const {
+    return m_shape;
+}
+
+const mat4& InstanceSet::getTransform(Index instance) const {
+    return *reinterpret_cast<const mat4*>(&m_data[instance * m_stride]);
+}
+
+uint InstanceSet::getInstancesCount() const {
+    return m_data.size() / m_stride;
+}
+
+uint InstanceSet::getVisibleCount() const {
+    return m_visibleCount;
+}
+
+ArrayBuffer* InstanceSet::getBuffer() const {
+    return m_buffer;
+}
+
+float* InstanceSet::instance(Index index) {
+    return &m_data[index * m_stride];
+}
+
+void InstanceSet::upload(const vector<float> &data, uint instancesCount) {
+    m_visibleCount = instancesCount;
+
+    if (instancesCount == 0)
+        return;
+
+    // orphaning: previous frame draws can still read the buffer
+    m_buffer->bind();
+    m_buffer->setData(instancesCount * m_stride * sizeof(float), data.data(), Buffer::StreamDraw);
+    m_buffer->unbind();
+}
+}
@@ -5,6 +5,9 @@
 
 #include "internal/PublicObjectTools.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 using namespace std;
 using namespace glm;
 using namespace algine::internal;
@@ -26,6 +29,7 @@ Model::Model(Rotator::Type rotatorType)
 Model::Model() = default;
 
 Model::~Model() {
+    releaseAnimations();
     deletePtr(m_animator)
 }
 
@@ -33,20 +37,22 @@ void Model::transform() {
     m_transform = m_translation * m_rotation * m_scaling;
 }
 
-#define configureAnimationList() m_animBones.resize(m_shape->getAnimationsAmount())
+#define configureAnimationList() m_animSlots.resize(m_shape->getAnimationsAmount(), PosePool::InvalidSlot)
 
 void Model::activateAnimations() {
     configureAnimationList();
 
-    for (auto &m_animBone : m_animBones) {
-        m_animBone.resize(m_shape->getBonesAmount());
+    for (Index i = 0; i < m_animSlots.size(); i++) {
+        activateAnimation(i);
     }
 }
 
 void Model::activateAnimation(Index index) {
     configureAnimationList();
 
-    m_animBones[index].resize(m_shape->getBonesAmount());
+    if (m_animSlots[index] == PosePool::InvalidSlot) {
+        m_animSlots[index] = m_posePool->acquire(m_shape->getBonesAmount());
+    }
 }
 
 void Model::activateAnimation(const std::string &name) {
@@ -56,7 +62,13 @@ void Model::activateAnimation(const std::string &name) {
 void Model::deactivateAnimation(Index index) {
     configureAnimationList();
 
-    m_animBones[index] = {};
+    if (auto &slot = m_animSlots[index]; slot != PosePool::InvalidSlot) {
+        if (m_bones == &m_posePool->get(slot))
+            m_bones = nullptr;
+
+        m_posePool->release(slot);
+        slot = PosePool::InvalidSlot;
+    }
 }
 
 void Model::deactivateAnimation(const std::string &name) {
@@ -64,16 +76,30 @@ void Model::deactivateAnimation(const std::string &name) {
 }
 
 bool Model::isAnimationActivated(uint index) const {
-    return m_animBones[index].size() == m_shape->getBonesAmount();
+    return index < m_animSlots.size() && m_animSlots[index] != PosePool::InvalidSlot;
 }
 
 bool Model::isBonesPresent() const {
     return m_shape->isBonesPresent();
 }
 
+bool Model::isBoneTransformationsCustom() const {
+    return m_customBoneTransformations;
+}
+
+uint Model::getBonesVersion() const {
+    return m_bonesVersion;
+}
+
+uint Model::getBoneTransformationsVersion() const {
+    return m_boneTransformationsVersion;
+}
+
 void Model::setBoneTransform(const string &boneName, const BoneMatrix &transformation) {
     if (uint index = m_shape->m_bones.getIndex(boneName); index != BonesStorage::BoneNotFound) {
         m_boneTransformations[index] = transformation;
+        m_customBoneTransformations = true;
+        m_boneTransformationsVersion++;
     } else {
         throw runtime_error("Bone " + boneName + " does not found");
     }
@@ -82,12 +108,17 @@ void Model::setBoneTransform(const string &boneName, const BoneMatrix &transform
 void Model::setBoneTransform(Index index, const BoneMatrix &transformation) {
     if (index < m_boneTransformations.size()) {
         m_boneTransformations[index] = transformation;
+        m_customBoneTransformations = true;
+        m_boneTransformationsVersion++;
     } else {
         throw runtime_error("index >= m_boneTransformations.size()");
     }
 }
 
 void Model::setShape(const ShapePtr &shape) {
+    // bones amount of the new shape can be different
+    releaseAnimations();
+
     m_shape = shape;
 
     configureAnimationList();
@@ -97,22 +128,24 @@ void Model::setShape(const ShapePtr &shape) {
             m_animator = new Animator(this);
         }
 
-        // nullptr check because m_bones could be already set
-        if (m_bones == nullptr) {
-            m_bones = &m_animBones[0];
-        }
+        // bones are set lazily, when an animation is sampled, so
+        // pose pool slots are acquired only for the sampled animations
     }
 
     // configure transformations array
     m_boneTransformations.resize(m_shape->getBonesAmount(), mat4(1.0));
+
+    m_morphWeights.assign(m_shape->getMorphTargets().getTargetsCount(), 0.0f);
 }
 
 void Model::setBones(const BoneMatrices *bones) {
+    // the caller can reuse the same matrices with new content
     m_bones = bones;
+    invalidateBones();
 }
 
 void Model::setBonesFromAnimation(Index animationIndex) {
-    m_bones = &m_animBones[animationIndex];
+    setBones(&animationBones(animationIndex));
 }
 
 void Model::setBonesFromAnimation(const string &animationName) {
@@ -121,6 +154,63 @@ void Model::setBonesFromAnimation(const string &animationName) {
 
 void Model::setBoneTransformations(const BoneMatrices &transformations) {
     m_boneTransformations = transformations;
+    m_customBoneTransformations = true;
+    m_boneTransformationsVersion++;
+}
+
+void Model::resetBoneTransformations() {
+    std::fill(m_boneTransformations.begin(), m_boneTransformations.end(), mat4(1.0));
+    m_customBoneTransformations = false;
+    m_boneTransformationsVersion++;
+}
+
+void Model::invalidateBones() {
+    m_bonesVersion++;
+}
+
+void Model::setMorphWeight(Index index, float weight) {
+    m_morphWeights[index] = weight;
+}
+
+void Model::setMorphWeight(const string &targetName, float weight) {
+    auto index = m_shape->getMorphTargets().getTargetIndex(targetName);
+
+    if (index == MorphTargets::TargetNotFound)
+        throw invalid_argument("Morph target '" + targetName + "' not found");
+
+    setMorphWeight(index, weight);
+}
+
+void Model::setPosePool(const PosePoolPtr &pool) {
+    for (auto &slot : m_animSlots) {
+        if (slot == PosePool::InvalidSlot)
+            continue;
+
+        auto &bones = m_posePool->get(slot);
+        auto newSlot = pool->acquire(bones.size());
+        auto &newBones = pool->get(newSlot);
+
+        newBones = bones;
+
+        if (m_bones == &bones)
+            m_bones = &newBones;
+
+        m_posePool->release(slot);
+        slot = newSlot;
+    }
+
+    m_posePool = pool;
+}
+
+void Model::setBakedAnimation(const BakedAnimation *animation, float phaseOffset) {
+    m_bakedAnimation = animation;
+    m_bakedPhaseOffset = phaseOffset;
+}
+
+void Model::updateBakedBones(float timeInSeconds) {
+    m_bakedAnimation->sample(timeInSeconds, m_bakedPhaseOffset, m_bakedBones);
+    m_bones = &m_bakedBones;
+    invalidateBones();
 }
 
 const ShapePtr& Model::getShape() const {
@@ -147,6 +237,39 @@ const BoneMatrices& Model::getBoneTransformations() const {
     return m_boneTransformations;
 }
 
+const PosePoolPtr& Model::getPosePool() const {
+    return m_posePool;
+}
+
+const BakedAnimation* Model::getBakedAnimation() const {
+    return m_bakedAnimation;
+}
+
+BakedAnimation::Pose Model::getBakedPose(float timeInSeconds) const {
+    return m_bakedAnimation->getPose(timeInSeconds, m_bakedPhaseOffset);
+}
+
+float Model::getBakedPhaseOffset() const {
+    return m_bakedPhaseOffset;
+}
+
+const vector<float>& Model::getMorphWeights() const {
+    return m_morphWeights;
+}
+
+BoneMatrices& Model::animationBones(Index index) {
+    activateAnimation(index);
+    return m_posePool->get(m_animSlots[index]);
+}
+
+void Model::releaseAnimations() {
+    for (Index i = 0; i < m_animSlots.size(); i++) {
+        deactivateAnimation(i);
+    }
+
+    m_animSlots.clear();
+}
+
 ModelPtr Model::getByName(const string &name) {
     return PublicObjectTools::getByName<ModelPtr>(name);
 }
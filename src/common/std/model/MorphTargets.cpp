@@ -0,0 +1,169 @@
+#define GLM_FORCE_CTOR_INIT
+#include <algine/std/model/MorphTargets.h>
+
+#include <algine/constants/MorphTargets.h>
+
+#include <tulz/macros.h>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace glm;
+
+namespace algine {
+constexpr float normalScale = 2.0f; // normal deltas are in [-2, 2]
+
+inline uint quantize(float value) {
+    auto q = static_cast<int16>(std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    return static_cast<uint16>(q);
+}
+
+inline uint pack(float lo, float hi) {
+    return quantize(lo) | (quantize(hi) << 16u);
+}
+
+MorphTargets::~MorphTargets() {
+    deletePtr(m_texture)
+    deletePtr(m_buffer)
+}
+
+void MorphTargets::addTarget(const string &name, const string &meshName, const vector<uint> &vertices,
+                             const vector<vec3> &positionDeltas, const vector<vec3> &normalDeltas)
+{
+    Target target;
+    target.name = name;
+    target.meshName = meshName;
+    target.start = m_deltas.size();
+    target.count = vertices.size();
+
+    for (const auto &delta : positionDeltas) {
+        target.positionScale = std::max(target.positionScale, std::abs(delta.x));
+        target.positionScale = std::max(target.positionScale, std::abs(delta.y));
+        target.positionScale = std::max(target.positionScale, std::abs(delta.z));
+    }
+
+    float scale = target.positionScale != 0.0f ? 1.0f / target.positionScale : 0.0f;
+
+    for (usize i = 0; i < vertices.size(); i++) {
+        vec3 position = positionDeltas[i] * scale;
+        vec3 normal = normalDeltas.empty() ? vec3(0.0f) : normalDeltas[i] / normalScale;
+
+        m_deltas.emplace_back(vertices[i], pack(position.x, position.y), pack(position.z, normal.x), pack(normal.y, normal.z));
+    }
+
+    if (auto it = m_meshTargets.find(meshName); it != m_meshTargets.end()) {
+        it->second.count++;
+    } else {
+        m_meshTargets[meshName] = {static_cast<Index>(m_targets.size()), 1};
+    }
+
+    m_targets.emplace_back(target);
+}
+
+void MorphTargets::createBuffer() {
+    if (m_deltas.empty())
+        return;
+
+    if (m_buffer == nullptr) {
+        m_buffer = new ArrayBuffer();
+        m_texture = new TextureBuffer();
+    }
+
+    m_buffer->bind();
+    m_buffer->setData(sizeof(uvec4) * m_deltas.size(), value_ptr(m_deltas[0]), Buffer::StaticDraw);
+    m_buffer->unbind();
+
+    m_texture->bind();
+    m_texture->setFormat(Texture::RGBA32UI);
+    m_texture->setBuffer(m_buffer);
+    m_texture->unbind();
+}
+
+void MorphTargets::setUniforms(ShaderProgram *program, const vector<float> &weights, uint textureSlot) const {
+    using namespace Module::MorphTargets::Vars;
+
+    m_activeTargets.clear();
+
+    for (Index i = 0; i < weights.size(); i++) {
+        if (weights[i] != 0.0f) {
+            m_activeTargets.emplace_back(i);
+        }
+    }
+
+    // top-K by absolute weight
+    auto activeCount = std::min<usize>(m_activeTargets.size(), m_maxActiveTargets);
+
+    std::partial_sort(m_activeTargets.begin(), m_activeTargets.begin() + activeCount, m_activeTargets.end(),
+        [&](Index lhs, Index rhs) {
+            return std::abs(weights[lhs]) > std::abs(weights[rhs]);
+        });
+
+    m_activeTargetsData.resize(activeCount);
+
+    for (usize i = 0; i < activeCount; i++) {
+        const auto &target = m_targets[m_activeTargets[i]];
+
+        m_activeTargetsData[i] = vec4(
+            static_cast<float>(target.start), static_cast<float>(target.count),
+            target.positionScale, weights[m_activeTargets[i]]);
+    }
+
+    if (m_texture != nullptr)
+        m_texture->use(textureSlot);
+
+    program->setInt(Deltas, static_cast<int>(textureSlot));
+    program->setInt(TargetsCount, static_cast<int>(activeCount));
+
+    if (activeCount > 0) {
+        program->setVec4(Targets, activeCount, m_activeTargetsData.data());
+    }
+}
+
+void MorphTargets::setMaxActiveTargets(uint count) {
+    m_maxActiveTargets = count;
+}
+
+Index MorphTargets::getTargetIndex(const string &name) const {
+    for (Index i = 0; i < m_targets.size(); i++) {
+        if (m_targets[i].name == name) {
+            return i;
+        }
+    }
+
+    return TargetNotFound;
+}
+
+Index MorphTargets::getTargetIndex(const string &meshName, Index meshTargetIndex) const {
+    if (auto it = m_meshTargets.find(meshName); it != m_meshTargets.end() && meshTargetIndex < it->second.count)
+        return it->second.first + meshTargetIndex;
+
+    return TargetNotFound;
+}
+
+const MorphTargets::Target& MorphTargets::getTarget(Index index) const {
+    return m_targets[index];
+}
+
+uint MorphTargets::getTargetsCount() const {
+    return m_targets.size();
+}
+
+uint MorphTargets::getMaxActiveTargets() const {
+    return m_maxActiveTargets;
+}
+
+bool MorphTargets::empty() const {
+    return m_targets.empty();
+}
+
+uint MorphTargets::getSizeInBytes() const {
+    return m_deltas.size() * sizeof(uvec4);
+}
+
+TextureBuffer* MorphTargets::getTexture() const {
+    return m_texture;
+}
+}
@@ -70,6 +70,7 @@ void Shape::setMeshes(const vector<Mesh> &meshes) {
 
 void Shape::setAnimations(const vector<Animation> &animations) {
     m_animations = animations;
+    updateSkeleton();
 }
 
 void Shape::addMesh(const Mesh &mesh) {
@@ -78,6 +79,11 @@ void Shape::addMesh(const Mesh &mesh) {
 
 void Shape::addAnimation(const Animation &animation) {
     m_animations.emplace_back(animation);
+    updateSkeleton();
+}
+
+void Shape::updateSkeleton() {
+    m_skeleton.build(*this);
 }
 
 bool Shape::isBonesPresent() const {
@@ -88,6 +94,10 @@ bool Shape::isAnimationsPresent() const {
     return !m_animations.empty();
 }
 
+bool Shape::isMorphTargetsPresent() const {
+    return !m_morphTargets.empty();
+}
+
 const std::vector<Mesh>& Shape::getMeshes() const {
     return m_meshes;
 }
@@ -112,6 +122,14 @@ const Node& Shape::getRootNode() const {
     return m_rootNode;
 }
 
+const Skeleton& Shape::getSkeleton() const {
+    return m_skeleton;
+}
+
+const MorphTargets& Shape::getMorphTargets() const {
+    return m_morphTargets;
+}
+
 uint Shape::getBonesPerVertex() const {
     return m_bonesPerVertex;
 }
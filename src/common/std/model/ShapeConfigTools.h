@@ -14,6 +14,7 @@ constant(CalcTangentSpace, "calcTangentSpace");
 constant(JoinIdenticalVertices, "joinIdenticalVertices");
 constant(InverseNormals, "inverseNormals");
 constant(DisableBones, "disableBones");
+constant(CompressAnimations, "compressAnimations");
 
 constant(InputLayoutLocations, "inputLayoutLocations");
 constant(BonesPerVertex, "bonesPerVertex");
@@ -28,6 +29,7 @@ inline string paramToString(ShapeManager::Param param) {
     param_str(JoinIdenticalVertices);
     param_str(InverseNormals);
     param_str(DisableBones);
+    param_str(CompressAnimations);
 
     throw runtime_error("Unsupported param " + to_string(static_cast<int>(param)));
 }
@@ -43,6 +45,7 @@ inline ShapeManager::Param stringToParam(const string &str) {
     param(JoinIdenticalVertices);
     param(InverseNormals);
     param(DisableBones);
+    param(CompressAnimations);
 
     throw runtime_error("Unsupported param '" + str + "'");
 }
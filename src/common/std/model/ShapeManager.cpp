@@ -89,6 +89,10 @@ void ShapeManager::setClassName(const string &name) {
     m_className = name;
 }
 
+void ShapeManager::setAnimationCompressor(const AnimationCompressor &compressor) {
+    m_animationCompressor = compressor;
+}
+
 const vector<ShapeManager::Param>& ShapeManager::getParams() const {
     return m_params;
 }
@@ -121,6 +125,10 @@ const string& ShapeManager::getClassName() const {
     return m_className;
 }
 
+const AnimationCompressor& ShapeManager::getAnimationCompressor() const {
+    return m_animationCompressor;
+}
+
 const vector<float>& ShapeManager::getVertices() const {
     return m_vertices;
 }
@@ -370,6 +378,26 @@ inline auto getParams(const vector<ShapeManager::Param> &params) {
     }
 }
 
+/**
+ * Some importers (e.g. glTF2) name morph channels after
+ * the node, so the channel affects all meshes of that node
+ */
+inline void resolveMorphChannel(MorphAnimNode &channel, const aiScene *scene) {
+    for (uint i = 0; i < scene->mNumMeshes; i++) {
+        if (channel.name == scene->mMeshes[i]->mName.data) {
+            return; // names the mesh
+        }
+    }
+
+    channel.meshNames.clear();
+
+    if (auto node = scene->mRootNode->FindNode(channel.name.c_str()); node != nullptr) {
+        for (uint i = 0; i < node->mNumMeshes; i++) {
+            channel.meshNames.emplace_back(scene->mMeshes[node->mMeshes[i]]->mName.data);
+        }
+    }
+}
+
 void ShapeManager::loadFile() {
     if (m_shape == nullptr) {
         m_shape.reset(TypeRegistry::create<Shape>(m_className));
@@ -401,6 +429,8 @@ void ShapeManager::loadFile() {
     }
 
     // load shape
+    m_morphMeshesLoaded.assign(scene->mNumMeshes, false);
+
     processNode(scene->mRootNode, scene);
 
     // load animations
@@ -409,7 +439,13 @@ void ShapeManager::loadFile() {
 
     for (size_t i = 0; i < scene->mNumAnimations; i++) {
         m_shape->m_animations.emplace_back(scene->mAnimations[i]);
+
+        for (auto &channel : m_shape->m_animations.back().morphChannels) {
+            resolveMorphChannel(channel, scene);
+        }
     }
+
+    m_shape->updateSkeleton();
 }
 
 void ShapeManager::loadShape() {
@@ -431,6 +467,20 @@ void ShapeManager::loadShape() {
                 m_bonesPerVertex = 0;
                 break;
             }
+            case Param::CompressAnimations: {
+                for (auto &animation : m_shape->m_animations) {
+                    auto info = m_animationCompressor.compress(animation);
+
+                    Log::info(TAG) << "Animation '" << animation.name << "' compressed: "
+                                   << info.originalSize << " -> " << info.compressedSize << " bytes, "
+                                   << "ratio " << info.ratio << ", max error: "
+                                   << "position " << info.maxPositionError << ", "
+                                   << "rotation " << info.maxRotationError << " rad, "
+                                   << "scaling " << info.maxScalingError << Log::end;
+                }
+
+                break;
+            }
             default: {
                 Log::error(TAG) << "Unknown algine param " << static_cast<uint>(p) << Log::end;
                 break;
@@ -517,13 +567,59 @@ void ShapeManager::loadBones(const aiMesh *aimesh) {
     }
 }
 
+void ShapeManager::loadMorphTargets(const aiMesh *aimesh, uint firstVertex) {
+    constexpr float epsilon = 1e-6f;
+
+    auto isChanged = [](const glm::vec3 &delta) {
+        return std::abs(delta.x) > epsilon || std::abs(delta.y) > epsilon || std::abs(delta.z) > epsilon;
+    };
+
+    vector<uint> vertices;
+    vector<glm::vec3> positions, normals;
+
+    for (uint i = 0; i < aimesh->mNumAnimMeshes; i++) {
+        const aiAnimMesh *animMesh = aimesh->mAnimMeshes[i];
+        bool hasNormals = animMesh->HasNormals() && aimesh->HasNormals();
+
+        vertices.clear();
+        positions.clear();
+        normals.clear();
+
+        // store only changed vertices
+        for (uint j = 0; j < aimesh->mNumVertices; j++) {
+            glm::vec3 position = getVec3(animMesh->mVertices[j]) - getVec3(aimesh->mVertices[j]);
+            glm::vec3 normal = hasNormals ? getVec3(animMesh->mNormals[j]) - getVec3(aimesh->mNormals[j]) : glm::vec3(0.0f);
+
+            if (isChanged(position) || isChanged(normal)) {
+                vertices.emplace_back(firstVertex + j);
+                positions.emplace_back(position);
+                normals.emplace_back(normal);
+            }
+        }
+
+        string meshName = aimesh->mName.data;
+        string name = animMesh->mName.length != 0 ? animMesh->mName.data : meshName + "." + to_string(i);
+
+        m_shape->m_morphTargets.addTarget(name, meshName, vertices, positions, normals);
+    }
+}
+
 void ShapeManager::processNode(const aiNode *node, const aiScene *scene) {
     // обработать все полигональные сетки в узле (если есть)
     for (size_t i = 0; i < node->mNumMeshes; i++) {
-        aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
+        uint meshIndex = node->mMeshes[i];
+        aiMesh *mesh = scene->mMeshes[meshIndex];
+        uint firstVertex = m_vertices.size() / 3;
 
         processMesh(mesh, scene);
 
+        // targets of one mesh must be contiguous, so they are loaded only for
+        // the first instance of the mesh; other instances are not morphed
+        if (mesh->mNumAnimMeshes != 0 && !m_morphMeshesLoaded[meshIndex]) {
+            loadMorphTargets(mesh, firstVertex);
+            m_morphMeshesLoaded[meshIndex] = true;
+        }
+
         if (m_bonesPerVertex != 0) {
             loadBones(mesh);
         }
@@ -736,5 +832,7 @@ void ShapeManager::genBuffers() {
     m_shape->m_boneIds = createBuffer<ArrayBuffer>(m_boneIds);
 
     m_shape->m_indices = createBuffer<IndexBuffer>(m_indices);
+
+    m_shape->m_morphTargets.createBuffer();
 }
 }